@@ -8,12 +8,18 @@ public class FirstPersonTest : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore","Niagara" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore","Niagara", "UMG" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
-		// Uncomment if you are using Slate UI
-		// PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+		// Slate is needed for the HUD layer invalidation/retainer boxes
+		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
+
+		// RenderCore exposes the game thread frame time read by the interaction benchmark
+		PrivateDependencyModuleNames.Add("RenderCore");
+
+		// AssetRegistry resolves short map names for level preloading without scanning the disk
+		PrivateDependencyModuleNames.Add("AssetRegistry");
 		
 		// Uncomment if you are using online features
 		// PrivateDependencyModuleNames.Add("OnlineSubsystem");
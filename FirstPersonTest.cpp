@@ -3,4 +3,23 @@
 #include "FirstPersonTest.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_STAT(STAT_ItemManagerRaycast);
+DEFINE_STAT(STAT_InteractionRaycast);
+DEFINE_STAT(STAT_PhysicsGrabTrace);
+DEFINE_STAT(STAT_PhysicsGrabForce);
+DEFINE_STAT(STAT_ThrowPreview);
+DEFINE_STAT(STAT_CameraSway);
+DEFINE_STAT(STAT_PuzzleManagerTick);
+DEFINE_STAT(STAT_GuideTrailSplines);
+DEFINE_STAT(STAT_BreakAngel);
+DEFINE_STAT(STAT_GameplayTraces);
+DEFINE_STAT(STAT_ImpactsQueued);
+DEFINE_STAT(STAT_ImpactSoundsPlayed);
+DEFINE_STAT(STAT_HeldItems);
+DEFINE_STAT(STAT_LiveShards);
+
+CSV_DEFINE_CATEGORY_MODULE(FIRSTPERSONTEST_API, Interaction, true);
+CSV_DEFINE_CATEGORY_MODULE(FIRSTPERSONTEST_API, GameplayUI, true);
+CSV_DEFINE_CATEGORY_MODULE(FIRSTPERSONTEST_API, PhysicsGrab, true);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, FirstPersonTest, "FirstPersonTest" );
@@ -3,4 +3,33 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
+// "stat FirstPersonTest" in game; the same scopes show up by name in Unreal Insights
+DECLARE_STATS_GROUP(TEXT("FirstPersonTest"), STATGROUP_FirstPersonTest, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Item Raycast"), STAT_ItemManagerRaycast, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Interaction Raycast"), STAT_InteractionRaycast, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Physics Grab Trace"), STAT_PhysicsGrabTrace, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Physics Grab Force"), STAT_PhysicsGrabForce, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Throw Preview"), STAT_ThrowPreview, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Camera Sway"), STAT_CameraSway, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Puzzle Manager Tick"), STAT_PuzzleManagerTick, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Guide Trail Splines"), STAT_GuideTrailSplines, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Break Angel"), STAT_BreakAngel, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+
+// Reset every frame
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_GameplayTraces, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Impacts Queued"), STAT_ImpactsQueued, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Impact Sounds Played"), STAT_ImpactSoundsPlayed, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+
+// Running totals
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Held Items"), STAT_HeldItems, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Shards"), STAT_LiveShards, STATGROUP_FirstPersonTest, FIRSTPERSONTEST_API);
+
+// CSV profiler categories ("-csvCategories=Interaction,GameplayUI,PhysicsGrab" or csvcategory in console)
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FIRSTPERSONTEST_API, Interaction);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FIRSTPERSONTEST_API, GameplayUI);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FIRSTPERSONTEST_API, PhysicsGrab);
@@ -0,0 +1,139 @@
+#include "CameraSwayModifier.h"
+#include "FirstPersonTest.h"
+#include "MyFPSCharacter.h"
+#include "CameraSwayProfile.h"
+#include "Camera/CameraTypes.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+const UCameraSwayProfile* UCameraSwayModifier::GetDefaultSprintProfile(const UCameraSwayProfile* Walk)
+{
+    // Rebuilt only when the character's walk profile changes
+    if (!DefaultSprintProfile || DefaultSprintSource.Get() != Walk)
+    {
+        DefaultSprintProfile = Walk->CreateDefaultSprintProfile(this);
+        DefaultSprintSource = Walk;
+    }
+    return DefaultSprintProfile;
+}
+
+bool UCameraSwayModifier::ModifyCamera(float DeltaTime, FMinimalViewInfo& InOutPOV)
+{
+    SCOPE_CYCLE_COUNTER(STAT_CameraSway);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UCameraSwayModifier::ModifyCamera);
+
+    Super::ModifyCamera(DeltaTime, InOutPOV);
+
+    AMyFPSCharacter* Character = Cast<AMyFPSCharacter>(GetViewTarget());
+    if (!Character || DeltaTime <= 0.0f)
+    {
+        return false;
+    }
+
+    const FVector Velocity = Character->GetVelocity();
+    const FRotator ActorRotation = Character->GetActorRotation();
+    const FVector LocalVelocity = ActorRotation.UnrotateVector(Velocity);
+    const float ForwardSpeed = LocalVelocity.X;
+    const float RightSpeed = LocalVelocity.Y;
+    const float SpeedSquared = Velocity.SizeSquared();
+
+    const bool bIsInAir = Character->GetCharacterMovement()->IsFalling();
+    const bool bJustLanded = bWasInAir && !bIsInAir;
+    bWasInAir = bIsInAir;
+
+    const UCameraSwayProfile* Walk = Character->WalkSwayProfile ? Character->WalkSwayProfile : GetDefault<UCameraSwayProfile>();
+    const UCameraSwayProfile* Profiles[NumProfiles];
+    Profiles[IdleProfile] = Character->IdleSwayProfile ? Character->IdleSwayProfile : Walk;
+    Profiles[WalkProfile] = Walk;
+    Profiles[SprintProfile] = Character->SprintSwayProfile ? Character->SprintSwayProfile : GetDefaultSprintProfile(Walk);
+
+    int32 TargetProfile = WalkProfile;
+    if (!bIsInAir && SpeedSquared <= 100.0f)
+    {
+        TargetProfile = IdleProfile;
+    }
+    else if (Character->bIsSprinting && !bIsInAir)
+    {
+        TargetProfile = SprintProfile;
+    }
+
+    float WeightSum = 0.0f;
+    for (int32 Index = 0; Index < NumProfiles; ++Index)
+    {
+        ProfileWeights[Index] = FMath::FInterpTo(ProfileWeights[Index], Index == TargetProfile ? 1.0f : 0.0f, DeltaTime, Character->SwayProfileBlendSpeed);
+        WeightSum += ProfileWeights[Index];
+    }
+    for (int32 Index = 0; Index < NumProfiles; ++Index)
+    {
+        ProfileWeights[Index] /= WeightSum;
+    }
+
+    auto Blend = [&](float UCameraSwayProfile::* Value)
+    {
+        float Result = 0.0f;
+        for (int32 Index = 0; Index < NumProfiles; ++Index)
+        {
+            Result += ProfileWeights[Index] * (Profiles[Index]->*Value);
+        }
+        return Result;
+    };
+
+    // Profiles that have fully faded out cost nothing
+    auto BlendSample = [&](ECameraSwayChannel Channel, float Phase, float UCameraSwayProfile::* Scale)
+    {
+        float Result = 0.0f;
+        for (int32 Index = 0; Index < NumProfiles; ++Index)
+        {
+            if (ProfileWeights[Index] > KINDA_SMALL_NUMBER)
+            {
+                Result += ProfileWeights[Index] * Profiles[Index]->Sample(Channel, Phase) * (Profiles[Index]->*Scale);
+            }
+        }
+        return Result;
+    };
+
+    if (bJustLanded)
+    {
+        const float ImpactStrength = FMath::Abs(LastZVelocity) / 500.0f;
+        CurrentPositionalSway.Z -= Blend(&UCameraSwayProfile::LandingBobAmount) * ImpactStrength;
+    }
+    LastZVelocity = Velocity.Z;
+
+    const float RotationalSwayAmount = Blend(&UCameraSwayProfile::RotationalSwayAmount) * Character->RotationalSwayScale;
+    FRotator TargetRotationalSway;
+    TargetRotationalSway.Pitch = -RightSpeed * 0.01f * RotationalSwayAmount + Blend(&UCameraSwayProfile::PitchOffset);
+    TargetRotationalSway.Yaw = ForwardSpeed * 0.005f * RotationalSwayAmount;
+    TargetRotationalSway.Roll = RightSpeed * 0.015f * RotationalSwayAmount;
+
+    FVector TargetPositionalSway = FVector::ZeroVector;
+
+    if (!bIsInAir)
+    {
+        // Advancing the phase, rather than deriving it from world time, keeps the bob continuous as speed changes
+        const float SpeedFactor = FMath::Sqrt(SpeedSquared) / Blend(&UCameraSwayProfile::BobReferenceSpeed);
+        BobPhase = FMath::Frac(BobPhase + DeltaTime * Blend(&UCameraSwayProfile::BobFrequency) * SpeedFactor);
+
+        TargetPositionalSway.Y = BlendSample(ECameraSwayChannel::BobLateral, BobPhase, &UCameraSwayProfile::BobAmount) * SpeedFactor;
+        TargetPositionalSway.Z = BlendSample(ECameraSwayChannel::BobVertical, BobPhase, &UCameraSwayProfile::BobAmount) * SpeedFactor;
+    }
+
+    BreathingPhase = FMath::Frac(BreathingPhase + DeltaTime * Blend(&UCameraSwayProfile::BreathingRate));
+    TargetRotationalSway.Pitch += BlendSample(ECameraSwayChannel::BreathingPitch, BreathingPhase, &UCameraSwayProfile::BreathingAmount);
+    TargetPositionalSway.Z += BlendSample(ECameraSwayChannel::BreathingHeight, BreathingPhase, &UCameraSwayProfile::BreathingAmount);
+
+    const float SwaySpeed = Blend(&UCameraSwayProfile::SwaySpeed);
+    CurrentRotationalSway = FMath::RInterpTo(CurrentRotationalSway, TargetRotationalSway, DeltaTime, SwaySpeed);
+    CurrentPositionalSway = FMath::VInterpTo(CurrentPositionalSway, TargetPositionalSway, DeltaTime, SwaySpeed);
+
+    if (!bIsInAir && Velocity.IsNearlyZero())
+    {
+        const float ReturnSpeed = Blend(&UCameraSwayProfile::ReturnSpeed);
+        CurrentRotationalSway = FMath::RInterpTo(CurrentRotationalSway, FRotator::ZeroRotator, DeltaTime, ReturnSpeed);
+        CurrentPositionalSway = FMath::VInterpTo(CurrentPositionalSway, FVector::ZeroVector, DeltaTime, ReturnSpeed);
+    }
+
+    // Positional sway is in the pawn's yaw frame, as it was when it moved the camera relative to the capsule
+    InOutPOV.Location += FRotator(0.0f, InOutPOV.Rotation.Yaw, 0.0f).RotateVector(CurrentPositionalSway * Alpha);
+    InOutPOV.Rotation += CurrentRotationalSway * Alpha;
+
+    return false;
+}
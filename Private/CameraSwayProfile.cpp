@@ -0,0 +1,88 @@
+#include "CameraSwayProfile.h"
+#include "Curves/CurveFloat.h"
+
+static_assert((UCameraSwayProfile::TableSize & (UCameraSwayProfile::TableSize - 1)) == 0, "Sample wraps the table index with a mask");
+
+namespace
+{
+    // The shapes the sway used when it was hardcoded, so an asset without curves behaves as before
+    float DefaultShape(ECameraSwayChannel Channel, float Phase)
+    {
+        switch (Channel)
+        {
+        case ECameraSwayChannel::BobLateral:
+            return FMath::Sin(2.0f * PI * Phase);
+        case ECameraSwayChannel::BobVertical:
+            return 0.5f * FMath::Sin(4.0f * PI * Phase);
+        case ECameraSwayChannel::BreathingPitch:
+            return FMath::Sin(2.0f * PI * Phase);
+        case ECameraSwayChannel::BreathingHeight:
+            return 1.5f * FMath::Sin(PI * Phase);
+        default:
+            return 0.0f;
+        }
+    }
+}
+
+void UCameraSwayProfile::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    // Covers the class default object, which the camera falls back to when no profile is assigned
+    BakeTables();
+}
+
+void UCameraSwayProfile::PostLoad()
+{
+    Super::PostLoad();
+
+    BakeTables();
+}
+
+#if WITH_EDITOR
+void UCameraSwayProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    BakeTables();
+}
+#endif
+
+void UCameraSwayProfile::BakeTables()
+{
+    UCurveFloat* const Curves[(int32)ECameraSwayChannel::Num] = { BobLateralCurve, BobVerticalCurve, BreathingPitchCurve, BreathingHeightCurve };
+
+    for (int32 ChannelIndex = 0; ChannelIndex < (int32)ECameraSwayChannel::Num; ++ChannelIndex)
+    {
+        UCurveFloat* Curve = Curves[ChannelIndex];
+        if (Curve)
+        {
+            // Hard references are not guaranteed to have finished loading when our own PostLoad runs
+            Curve->ConditionalPostLoad();
+        }
+
+        for (int32 Index = 0; Index < TableSize; ++Index)
+        {
+            const float Phase = (float)Index / TableSize;
+            Tables[ChannelIndex][Index] = Curve ? Curve->GetFloatValue(Phase) : DefaultShape((ECameraSwayChannel)ChannelIndex, Phase);
+        }
+    }
+}
+
+UCameraSwayProfile* UCameraSwayProfile::CreateDefaultSprintProfile(UObject* Outer) const
+{
+    // Using this profile as the template copies the curves before PostInitProperties bakes them
+    UCameraSwayProfile* Sprint = NewObject<UCameraSwayProfile>(Outer, NAME_None, RF_Transient, const_cast<UCameraSwayProfile*>(this));
+    Sprint->PitchOffset += DefaultSprintPitchOffset;
+    Sprint->BobAmount *= DefaultSprintBobScale;
+    return Sprint;
+}
+
+float UCameraSwayProfile::Sample(ECameraSwayChannel Channel, float Phase) const
+{
+    const float Position = FMath::Frac(Phase) * TableSize;
+    const int32 Index = FMath::FloorToInt(Position);
+    const float* Table = Tables[(int32)Channel];
+
+    return FMath::Lerp(Table[Index & (TableSize - 1)], Table[(Index + 1) & (TableSize - 1)], Position - Index);
+}
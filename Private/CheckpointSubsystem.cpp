@@ -0,0 +1,320 @@
+#include "CheckpointSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "TimerManager.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Components/StaticMeshComponent.h"
+#include "GameplayActorRegistry.h"
+#include "PlayerOxygenSystem.h"
+#include "PuzzleManager.h"
+#include "P_FixableMachine.h"
+#include "PickableItem.h"
+#include "ItemManager.h"
+#include "OxygenReplenishActor.h"
+#include "MyFPSCharacter.h"
+#include "GameSaveCodec.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/Crc.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+void UCheckpointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Subsystems hear about begin play before the game mode starts it, so no actor has run BeginPlay
+    // (or registered) yet. By the next tick every actor has.
+    InWorld.GetTimerManager().SetTimerForNextTick(this, &UCheckpointSubsystem::CaptureLevelDefaults);
+}
+
+void UCheckpointSubsystem::CaptureLevelDefaults()
+{
+    CaptureSnapshot(LevelDefaults);
+    Checkpoint = LevelDefaults;
+
+    if (!LevelDefaults.bValid)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Checkpoint: No player or oxygen system at level start, checkpoints are disabled"));
+    }
+}
+
+void UCheckpointSubsystem::Deinitialize()
+{
+    // Don't let the process exit (or the next map start) with a save half written
+    if (LastSaveTask.IsValid())
+    {
+        FTaskGraphInterface::Get().WaitUntilTaskCompletes(LastSaveTask);
+        LastSaveTask = nullptr;
+    }
+
+    Super::Deinitialize();
+}
+
+namespace
+{
+    // Must be identical across runs, unlike FName hashes which follow name-pool indices
+    uint32 StableHash(const FString& String)
+    {
+        return FCrc::StrCrc32(*String);
+    }
+}
+
+UCheckpointSubsystem* UCheckpointSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UCheckpointSubsystem>() : nullptr;
+}
+
+void UCheckpointSubsystem::CaptureCheckpoint()
+{
+    CaptureSnapshot(Checkpoint);
+
+    if (bAutosaveOnCheckpoint && Checkpoint.bValid)
+    {
+        WriteSnapshotAsync(Checkpoint, AutosaveSlotName);
+    }
+}
+
+void UCheckpointSubsystem::CaptureSnapshot(FCheckpointSnapshot& Snapshot) const
+{
+    UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this);
+    if (!Registry)
+    {
+        Snapshot.bValid = false;
+        return;
+    }
+
+    Snapshot.Puzzles.Reset();
+    Snapshot.Items.Reset();
+    Snapshot.ReplenishActors.Reset();
+
+    uint32 LayoutHash = StableHash(UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName()));
+
+    APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+    APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+    if (Pawn)
+    {
+        Snapshot.PlayerTransform = Pawn->GetActorTransform();
+        Snapshot.ControlRotation = PC->GetControlRotation();
+    }
+
+    APlayerOxygenSystem* OxygenSystem = Registry->Find<APlayerOxygenSystem>();
+    if (OxygenSystem)
+    {
+        Snapshot.Oxygen = OxygenSystem->CurrentOxygen;
+    }
+
+    if (APuzzleManager* PuzzleManager = Registry->Find<APuzzleManager>())
+    {
+        Snapshot.CurrentPuzzleIndex = PuzzleManager->GetCurrentPuzzleIndex();
+        for (const FPuzzleData& Puzzle : PuzzleManager->PuzzleData)
+        {
+            // Room machines come and go with their sublevel, so they are identified by their soft path
+            const uint32 MachineHash = !Puzzle.RoomMachine.IsNull() ? StableHash(Puzzle.RoomMachine.ToSoftObjectPath().ToString())
+                : Puzzle.Machine ? StableHash(Puzzle.Machine->GetName()) : 0;
+            LayoutHash = HashCombine(LayoutHash, MachineHash);
+
+            FPuzzleCheckpoint& Entry = Snapshot.Puzzles.AddDefaulted_GetRef();
+            Entry.CompletionPercentage = Puzzle.CompletionPercentage;
+            Entry.bIsCompleted = Puzzle.bIsCompleted;
+            Entry.bIsActive = Puzzle.bIsActive;
+            if (Puzzle.Machine && IsValid(Puzzle.Machine))
+            {
+                Entry.MachineProgress = Puzzle.Machine->GetFixingProgress();
+                Entry.bMachineFixed = Puzzle.Machine->IsFixed();
+            }
+        }
+    }
+
+    // Items in streamed rooms are not resident at every capture, so only persistent-level items are tracked
+    Registry->ForEach<APickableItem>([&Snapshot, &LayoutHash](APickableItem* Item)
+    {
+        if (!Item->GetLevel() || !Item->GetLevel()->IsPersistentLevel())
+        {
+            return;
+        }
+        Snapshot.Items.Add({ Item, Item->GetActorTransform() });
+        LayoutHash = HashCombine(LayoutHash, StableHash(Item->GetName()));
+    });
+
+    Registry->ForEach<AOxygenReplenishActor>([&Snapshot, &LayoutHash](AOxygenReplenishActor* Replenish)
+    {
+        Snapshot.ReplenishActors.Add({ Replenish, Replenish->IsConsumed() });
+        LayoutHash = HashCombine(LayoutHash, StableHash(Replenish->GetName()));
+    });
+
+    Snapshot.LayoutHash = LayoutHash;
+    // Restoring a snapshot without oxygen would hand the player zero air and kill them again at once
+    Snapshot.bValid = Pawn && OxygenSystem;
+}
+
+bool UCheckpointSubsystem::RestoreCheckpoint()
+{
+    UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this);
+    if (!Checkpoint.bValid || !Registry)
+    {
+        return false;
+    }
+
+    APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+    APawn* Pawn = PC ? PC->GetPawn() : nullptr;
+    if (!Pawn)
+    {
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Checkpoint: Restoring in place"));
+
+    // Let go of anything in hand before items are moved back
+    if (AItemManager* ItemManager = Registry->Find<AItemManager>())
+    {
+        ItemManager->ReleaseHeldItemImmediately();
+    }
+    if (AMyFPSCharacter* Character = Cast<AMyFPSCharacter>(Pawn))
+    {
+        Character->StopPhysicsGrab();
+    }
+
+    Pawn->SetActorTransform(Checkpoint.PlayerTransform, false, nullptr, ETeleportType::TeleportPhysics);
+    PC->SetControlRotation(Checkpoint.ControlRotation);
+    if (ACharacter* Character = Cast<ACharacter>(Pawn))
+    {
+        Character->GetCharacterMovement()->StopMovementImmediately();
+    }
+
+    if (APlayerOxygenSystem* OxygenSystem = Registry->Find<APlayerOxygenSystem>())
+    {
+        OxygenSystem->RestoreOxygen(FMath::Max(Checkpoint.Oxygen, LevelDefaults.Oxygen * MinRestoredOxygenFraction));
+    }
+
+    APuzzleManager* PuzzleManager = Registry->Find<APuzzleManager>();
+    if (PuzzleManager && PuzzleManager->PuzzleData.Num() == Checkpoint.Puzzles.Num())
+    {
+        for (int32 i = 0; i < Checkpoint.Puzzles.Num(); ++i)
+        {
+            const FPuzzleCheckpoint& Entry = Checkpoint.Puzzles[i];
+            FPuzzleData& Puzzle = PuzzleManager->PuzzleData[i];
+            Puzzle.CompletionPercentage = Entry.CompletionPercentage;
+            Puzzle.bIsCompleted = Entry.bIsCompleted;
+            Puzzle.bIsActive = Entry.bIsActive;
+            if (Puzzle.Machine && IsValid(Puzzle.Machine))
+            {
+                Puzzle.Machine->RestoreState(Entry.MachineProgress, Entry.bMachineFixed);
+            }
+        }
+        PuzzleManager->RefreshRestoredState(Checkpoint.CurrentPuzzleIndex);
+    }
+
+    for (const FItemCheckpoint& Entry : Checkpoint.Items)
+    {
+        if (APickableItem* Item = Entry.Item.Get())
+        {
+            Item->SetActorTransform(Entry.Transform, false, nullptr, ETeleportType::ResetPhysics);
+            if (UStaticMeshComponent* Mesh = Item->GetMesh())
+            {
+                Mesh->SetPhysicsLinearVelocity(FVector::ZeroVector);
+                Mesh->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+            }
+        }
+    }
+
+    for (const FReplenishCheckpoint& Entry : Checkpoint.ReplenishActors)
+    {
+        if (AOxygenReplenishActor* Replenish = Entry.Actor.Get())
+        {
+            Replenish->SetConsumed(Entry.bConsumed);
+        }
+    }
+
+    return true;
+}
+
+FString UCheckpointSubsystem::GetSlotPath(const FString& SlotName)
+{
+    return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".fpsave");
+}
+
+void UCheckpointSubsystem::SaveToSlot(const FString& SlotName)
+{
+    FCheckpointSnapshot State;
+    CaptureSnapshot(State);
+    if (State.bValid)
+    {
+        WriteSnapshotAsync(MoveTemp(State), SlotName);
+    }
+}
+
+void UCheckpointSubsystem::WriteSnapshotAsync(FCheckpointSnapshot State, const FString& SlotName)
+{
+    if (!LevelDefaults.bValid)
+    {
+        return;
+    }
+
+    // Saves hold per-index deltas against the defaults, which only mean anything for the same set of actors
+    if (!FGameSaveCodec::MatchesLayout(State, LevelDefaults))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Checkpoint: Not saving %s, the level's puzzles, items or replenishers no longer match the level start"), *SlotName);
+        return;
+    }
+
+    // Writes go to a temp file that is renamed into place, so a crash never leaves a torn slot.
+    // Each write is chained after the previous one, so an older save can never land on top of a newer one.
+    const FString Path = GetSlotPath(SlotName);
+    const FString TempPath = FString::Printf(TEXT("%s.%d.tmp"), *Path, ++SaveSerial);
+
+    FGraphEventArray Prerequisites;
+    if (LastSaveTask.IsValid() && !LastSaveTask->IsComplete())
+    {
+        Prerequisites.Add(LastSaveTask);
+    }
+
+    LastSaveTask = FFunctionGraphTask::CreateAndDispatchWhenReady([State = MoveTemp(State), Defaults = LevelDefaults, Path, TempPath]()
+    {
+        TArray<uint8> Bytes;
+        const bool bSaved = FGameSaveCodec::Encode(State, Defaults, Bytes) && FFileHelper::SaveArrayToFile(Bytes, *TempPath) && IFileManager::Get().Move(*Path, *TempPath, true, true);
+        if (bSaved)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Checkpoint: Saved %d bytes to %s"), Bytes.Num(), *Path);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Checkpoint: Failed to write %s"), *Path);
+            IFileManager::Get().Delete(*TempPath, false, false, true);
+        }
+    }, TStatId(), &Prerequisites, ENamedThreads::AnyBackgroundThreadNormalTask);
+}
+
+bool UCheckpointSubsystem::LoadFromSlot(const FString& SlotName)
+{
+    if (!LevelDefaults.bValid)
+    {
+        return false;
+    }
+
+    // Read what was last asked to be saved, not what happened to be on disk before it
+    if (LastSaveTask.IsValid())
+    {
+        FTaskGraphInterface::Get().WaitUntilTaskCompletes(LastSaveTask);
+    }
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *GetSlotPath(SlotName), FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    FCheckpointSnapshot Loaded;
+    if (!FGameSaveCodec::Decode(Bytes, LevelDefaults, Loaded))
+    {
+        return false;
+    }
+
+    Checkpoint = MoveTemp(Loaded);
+    return RestoreCheckpoint();
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "Engine/AssetManager.h"
+#include "LevelTransitionSubsystem.h"
 
 ADialoguePlayer::ADialoguePlayer()
 {
@@ -43,9 +45,19 @@ void ADialoguePlayer::BeginPlay()
                     SetupInputBindings();
                 }
                 
-                // Start dialogue with intro delay
-                FTimerHandle TimerHandle;
-                GetWorldTimerManager().SetTimer(TimerHandle, this, &ADialoguePlayer::StartDialogue, IntroDelay, false);
+                if (DialogueTable.IsNull())
+                {
+                    // Start dialogue with intro delay
+                    FTimerHandle TimerHandle;
+                    GetWorldTimerManager().SetTimer(TimerHandle, this, &ADialoguePlayer::StartDialogue, IntroDelay, false);
+                }
+                else
+                {
+                    // Stream the script in; the intro delay starts once it is resident
+                    DialogueTableHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+                        DialogueTable.ToSoftObjectPath(),
+                        FStreamableDelegate::CreateUObject(this, &ADialoguePlayer::OnDialogueTableLoaded));
+                }
             }
             else
             {
@@ -63,6 +75,41 @@ void ADialoguePlayer::BeginPlay()
     }
 }
 
+void ADialoguePlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (DialogueTableHandle.IsValid())
+    {
+        DialogueTableHandle->CancelHandle();
+        DialogueTableHandle.Reset();
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+void ADialoguePlayer::OnDialogueTableLoaded()
+{
+    UDataTable* Table = DialogueTable.Get();
+    if (!Table)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to load DialogueTable %s"), *DialogueTable.ToString());
+        return;
+    }
+    
+    TArray<FDialogueEntry*> Rows;
+    Table->GetAllRows<FDialogueEntry>(TEXT("ADialoguePlayer::OnDialogueTableLoaded"), Rows);
+    
+    DialogueEntries.Reset(Rows.Num());
+    for (const FDialogueEntry* Row : Rows)
+    {
+        DialogueEntries.Add(*Row);
+    }
+    
+    UE_LOG(LogTemp, Display, TEXT("Loaded %d dialogue entries from %s"), DialogueEntries.Num(), *Table->GetName());
+    
+    FTimerHandle TimerHandle;
+    GetWorldTimerManager().SetTimer(TimerHandle, this, &ADialoguePlayer::StartDialogue, IntroDelay, false);
+}
+
 void ADialoguePlayer::SetupInputBindings()
 {
     // Get the player controller
@@ -174,8 +221,18 @@ void ADialoguePlayer::AdvanceDialogue()
     {
         // Show next dialogue
         const FDialogueEntry& Entry = DialogueEntries[CurrentDialogueIndex];
-        UE_LOG(LogTemp, Display, TEXT("Showing dialogue: \"%s\""), *Entry.Text);
-        SetDialogueText(Entry.Text, Entry.TextColor, Entry.TypeSpeed);
+        const FText DisplayText = Entry.GetDisplayText();
+        UE_LOG(LogTemp, Display, TEXT("Showing dialogue: \"%s\""), *DisplayText.ToString());
+        SetDialogueTextFromText(DisplayText, Entry.TextColor, Entry.TypeSpeed);
+        
+        // Last line: load the next scene while it is being read
+        if (CurrentDialogueIndex == DialogueEntries.Num() - 1 && !NextLevelName.IsNone())
+        {
+            if (ULevelTransitionSubsystem* Transition = ULevelTransitionSubsystem::Get(this))
+            {
+                Transition->PreloadLevel(NextLevelName);
+            }
+        }
     }
     else
     {
@@ -186,11 +243,17 @@ void ADialoguePlayer::AdvanceDialogue()
 }
 
 void ADialoguePlayer::SetDialogueText(const FString& NewText, const FLinearColor& TextColor, float Speed)
+{
+    SetDialogueTextFromText(FText::FromString(NewText), TextColor, Speed);
+}
+
+void ADialoguePlayer::SetDialogueTextFromText(const FText& NewText, const FLinearColor& TextColor, float Speed)
 {
     if (TextLabel)
     {
-        // Initialize typewriter variables
-        TargetText = NewText;
+        // Resolve the (possibly localized) text once per line for the typewriter
+        TargetDisplayText = NewText;
+        TargetText = NewText.ToString();
         CurrentText = "";
         CurrentCharIndex = 0;
         CurrentDelay = 0.0f;
@@ -205,7 +268,7 @@ void ADialoguePlayer::SetDialogueText(const FString& NewText, const FLinearColor
         // Clear existing text
         TextLabel->SetText(FText::FromString(""));
         
-        UE_LOG(LogTemp, Display, TEXT("Set dialogue text: \"%s\" with speed %f"), *NewText, Speed);
+        UE_LOG(LogTemp, Display, TEXT("Set dialogue text: \"%s\" with speed %f"), *TargetText, Speed);
     }
     else
     {
@@ -221,7 +284,7 @@ void ADialoguePlayer::SkipTypewriter()
         
         // Skip to the end of the text
         CurrentText = TargetText;
-        TextLabel->SetText(FText::FromString(CurrentText));
+        TextLabel->SetText(TargetDisplayText);
         bIsTyping = false;
         bAllowInput = true;
         
@@ -275,6 +338,13 @@ void ADialoguePlayer::ChangeScene()
     // Then change to the next level if specified
     if (!NextLevelName.IsNone())
     {
-        UGameplayStatics::OpenLevel(this, NextLevelName);
+        if (ULevelTransitionSubsystem* Transition = ULevelTransitionSubsystem::Get(this))
+        {
+            Transition->TravelToLevel(NextLevelName);
+        }
+        else
+        {
+            UGameplayStatics::OpenLevel(this, NextLevelName);
+        }
     }
 }
\ No newline at end of file
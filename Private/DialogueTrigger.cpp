@@ -2,6 +2,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Components/TextBlock.h"
+#include "Engine/AssetManager.h"
 
 ADialogueTrigger::ADialogueTrigger()
 {
@@ -14,6 +15,11 @@ ADialogueTrigger::ADialogueTrigger()
 
     MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
     MeshComponent->SetupAttachment(RootComponent);
+
+    PreloadSphere = CreateDefaultSubobject<USphereComponent>(TEXT("PreloadSphere"));
+    PreloadSphere->SetupAttachment(RootComponent);
+    PreloadSphere->SetSphereRadius(1000.0f);
+    PreloadSphere->SetCollisionProfileName(TEXT("Trigger"));
     
     static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMeshFinder(TEXT("/Engine/BasicShapes/Cube"));
     if (CubeMeshFinder.Succeeded())
@@ -39,6 +45,22 @@ void ADialogueTrigger::BeginPlay()
     TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &ADialogueTrigger::OnTriggerBeginOverlap);
     TriggerBox->OnComponentEndOverlap.AddDynamic(this, &ADialogueTrigger::OnTriggerEndOverlap);
 
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->RegisterActor(this, TickSignificance);
+    }
+
+    if (DialogueTable.IsNull())
+    {
+        PreloadSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        bDialogueLoaded = true;
+    }
+    else
+    {
+        PreloadSphere->OnComponentBeginOverlap.AddDynamic(this, &ADialogueTrigger::OnPreloadBeginOverlap);
+        PreloadSphere->OnComponentEndOverlap.AddDynamic(this, &ADialogueTrigger::OnPreloadEndOverlap);
+    }
+
     if (DialogueWidgetClass)
     {
         APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
@@ -60,6 +82,13 @@ void ADialogueTrigger::BeginPlay()
     }
 }
 
+void ADialogueTrigger::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ReleaseDialogue();
+
+    Super::EndPlay(EndPlayReason);
+}
+
 void ADialogueTrigger::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
@@ -85,6 +114,9 @@ void ADialogueTrigger::OnTriggerEndOverlap(UPrimitiveComponent* OverlappedCompon
 {
     if (OtherActor && OtherActor->IsA(ACharacter::StaticClass()))
     {
+        // The player left before the script finished loading, so it should not pop up behind them
+        bStartWhenLoaded = false;
+
         if (bIsPlaying && CurrentState != EDialogueState::FadingOut)
         {
             CurrentState = EDialogueState::FadingOut;
@@ -93,15 +125,97 @@ void ADialogueTrigger::OnTriggerEndOverlap(UPrimitiveComponent* OverlappedCompon
     }
 }
 
+void ADialogueTrigger::OnPreloadBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+    if (OtherActor && OtherActor->IsA(ACharacter::StaticClass()))
+    {
+        if (!bHasBeenTriggered || bCanReplay)
+        {
+            PreloadDialogue();
+        }
+    }
+}
+
+void ADialogueTrigger::OnPreloadEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+    if (OtherActor && OtherActor->IsA(ACharacter::StaticClass()) && !bIsPlaying)
+    {
+        ReleaseDialogue();
+    }
+}
+
+void ADialogueTrigger::PreloadDialogue()
+{
+    if (DialogueTable.IsNull() || DialogueTableHandle.IsValid())
+        return;
+
+    DialogueTableHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        DialogueTable.ToSoftObjectPath(),
+        FStreamableDelegate::CreateUObject(this, &ADialogueTrigger::OnDialogueTableLoaded));
+}
+
+void ADialogueTrigger::ReleaseDialogue()
+{
+    bStartWhenLoaded = false;
+
+    if (DialogueTableHandle.IsValid())
+    {
+        DialogueTableHandle->CancelHandle();
+        DialogueTableHandle.Reset();
+        bDialogueLoaded = false;
+    }
+}
+
+void ADialogueTrigger::OnDialogueTableLoaded()
+{
+    UDataTable* Table = DialogueTable.Get();
+    const FDialogueEntry* Row = Table ? Table->FindRow<FDialogueEntry>(DialogueRowName, TEXT("ADialogueTrigger::OnDialogueTableLoaded")) : nullptr;
+    if (Row)
+    {
+        TableText = Row->GetDisplayText();
+        bHasTableText = true;
+        TypewriterSpeed = Row->TypeSpeed;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("DialogueTrigger %s: row %s not found in %s"), *GetName(), *DialogueRowName.ToString(), *DialogueTable.ToString());
+    }
+
+    bDialogueLoaded = true;
+
+    if (bStartWhenLoaded)
+    {
+        bStartWhenLoaded = false;
+        StartDialogue();
+    }
+}
+
 void ADialogueTrigger::StartDialogue()
 {
     if (bIsPlaying || !DialogueWidget || !DialogueLabel)
         return;
 
+    // Player outran the preload volume; start as soon as the script arrives
+    if (!bDialogueLoaded)
+    {
+        bStartWhenLoaded = true;
+        PreloadDialogue();
+        return;
+    }
+
     bIsPlaying = true;
     bHasBeenTriggered = true;
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->SetPinned(this, true);
+    }
+
+
     CurrentState = EDialogueState::FadingIn;
     
+    DisplayText = bHasTableText ? TableText
+        : LocalizedDialogueText.IsEmpty() ? FText::FromString(DialogueText) : LocalizedDialogueText;
+    ResolvedText = DisplayText.ToString();
     CurrentText = TEXT("");
     CurrentCharIndex = 0;
     TypewriterTimer = 0.0f;
@@ -120,11 +234,21 @@ void ADialogueTrigger::StopDialogue()
 
     bIsPlaying = false;
     CurrentState = EDialogueState::Idle;
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->SetPinned(this, false);
+    }
     
     if (DialogueWidget)
     {
         DialogueWidget->SetVisibility(ESlateVisibility::Hidden);
     }
+
+    // A one-shot script is never needed again
+    if (!bCanReplay)
+    {
+        ReleaseDialogue();
+    }
 }
 
 void ADialogueTrigger::ResetDialogue()
@@ -157,15 +281,16 @@ void ADialogueTrigger::UpdateDialogue(float DeltaTime)
             
             if (TypewriterTimer >= TypewriterSpeed)
             {
-                if (CurrentCharIndex < DialogueText.Len())
+                if (CurrentCharIndex < ResolvedText.Len())
                 {
-                    CurrentText += DialogueText[CurrentCharIndex];
+                    CurrentText += ResolvedText[CurrentCharIndex];
                     DialogueLabel->SetText(FText::FromString(CurrentText));
                     CurrentCharIndex++;
                     TypewriterTimer = 0.0f;
                 }
                 else
                 {
+                    DialogueLabel->SetText(DisplayText);
                     CurrentState = EDialogueState::Displaying;
                     DisplayTimer = 0.0f;
                 }
@@ -7,6 +7,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Sound/SoundBase.h"
+#include "GameplayActorRegistry.h"
+#include "LevelTransitionSubsystem.h"
 
 AGameConditionManager::AGameConditionManager()
 {
@@ -52,6 +54,11 @@ void AGameConditionManager::BeginPlay()
         TriggerBox->OnComponentEndOverlap.AddDynamic(this, &AGameConditionManager::OnTriggerEndOverlap);
     }
 
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->RegisterActor(this, TickSignificance);
+    }
+
     // Store original material
     if (MeshComponent && MeshComponent->GetMaterial(0))
     {
@@ -103,6 +110,15 @@ void AGameConditionManager::Tick(float DeltaTime)
     if (bPreviousState != bAllPuzzlesSolved)
     {
         OnConditionsMetChanged(CheckAllConditionsMet());
+        
+        // The exit is now reachable, so start streaming the next map in the background
+        if (bAllPuzzlesSolved)
+        {
+            if (ULevelTransitionSubsystem* Transition = ULevelTransitionSubsystem::Get(this))
+            {
+                Transition->PreloadLevel(NextLevelName);
+            }
+        }
     }
 }
 
@@ -195,7 +211,14 @@ void AGameConditionManager::ChangeToNextLevel()
     // Change level
     if (!NextLevelName.IsNone())
     {
-        UGameplayStatics::OpenLevel(this, NextLevelName);
+        if (ULevelTransitionSubsystem* Transition = ULevelTransitionSubsystem::Get(this))
+        {
+            Transition->TravelToLevel(NextLevelName);
+        }
+        else
+        {
+            UGameplayStatics::OpenLevel(this, NextLevelName);
+        }
     }
     else
     {
@@ -286,19 +309,19 @@ FText AGameConditionManager::GetInteractionText_Implementation() const
 
 void AGameConditionManager::FindPuzzleManager()
 {
-    // Find puzzle manager in the level
-    TArray<AActor*> FoundActors;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), APuzzleManager::StaticClass(), FoundActors);
-    
-    if (FoundActors.Num() > 0)
+    // Resolve the puzzle manager now, or as soon as it registers if it begins play after us
+    UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this);
+    if (!Registry)
     {
-        PuzzleManagerRef = Cast<APuzzleManager>(FoundActors[0]);
-        UE_LOG(LogTemp, Warning, TEXT("GameConditionManager: Found PuzzleManager"));
+        UE_LOG(LogTemp, Warning, TEXT("GameConditionManager: No actor registry for this world"));
+        return;
     }
-    else
+    
+    Registry->WhenRegistered<APuzzleManager>(this, [this](APuzzleManager* PuzzleManager)
     {
-        UE_LOG(LogTemp, Warning, TEXT("GameConditionManager: No PuzzleManager found in level"));
-    }
+        PuzzleManagerRef = PuzzleManager;
+        UE_LOG(LogTemp, Warning, TEXT("GameConditionManager: Found PuzzleManager"));
+    });
 }
 
 void AGameConditionManager::UpdateVisualFeedback()
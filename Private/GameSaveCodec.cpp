@@ -0,0 +1,318 @@
+#include "GameSaveCodec.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace GameSaveCodec
+{
+    enum EPuzzleFlags : uint8
+    {
+        PuzzleCompleted = 1 << 0,
+        PuzzleActive    = 1 << 1,
+        MachineFixed    = 1 << 2,
+    };
+
+    // Positions within a centimetre and rotations within about a hundredth of a degree are "unchanged"
+    constexpr float LocationTolerance = 1.0f;
+    constexpr float RotationTolerance = 1.e-4f;
+
+    // Values are stored as 32-bit floats regardless of the engine's vector precision
+    void SerializeVector(FArchive& Ar, FVector& Vector)
+    {
+        float X = Vector.X, Y = Vector.Y, Z = Vector.Z;
+        Ar << X << Y << Z;
+        Vector = FVector(X, Y, Z);
+    }
+
+    void SerializeRotator(FArchive& Ar, FRotator& Rotator)
+    {
+        float Pitch = Rotator.Pitch, Yaw = Rotator.Yaw, Roll = Rotator.Roll;
+        Ar << Pitch << Yaw << Roll;
+        Rotator = FRotator(Pitch, Yaw, Roll);
+    }
+
+    void SerializeQuat(FArchive& Ar, FQuat& Quat)
+    {
+        float X = Quat.X, Y = Quat.Y, Z = Quat.Z, W = Quat.W;
+        Ar << X << Y << Z << W;
+        Quat = FQuat(X, Y, Z, W);
+    }
+
+    void SerializeIndex(FArchive& Ar, int32& Index)
+    {
+        uint32 Packed = static_cast<uint32>(Index);
+        Ar.SerializeIntPacked(Packed);
+        Index = static_cast<int32>(Packed);
+    }
+
+    bool PuzzleDiffers(const FPuzzleCheckpoint& A, const FPuzzleCheckpoint& B)
+    {
+        return A.bIsCompleted != B.bIsCompleted || A.bIsActive != B.bIsActive || A.bMachineFixed != B.bMachineFixed
+            || !FMath::IsNearlyEqual(A.CompletionPercentage, B.CompletionPercentage)
+            || !FMath::IsNearlyEqual(A.MachineProgress, B.MachineProgress);
+    }
+
+    bool TransformDiffers(const FTransform& A, const FTransform& B)
+    {
+        return !A.GetLocation().Equals(B.GetLocation(), LocationTolerance)
+            || !A.GetRotation().Equals(B.GetRotation(), RotationTolerance);
+    }
+}
+
+bool FGameSaveCodec::MatchesLayout(const FCheckpointSnapshot& State, const FCheckpointSnapshot& Defaults)
+{
+    return State.Puzzles.Num() == Defaults.Puzzles.Num() && State.Items.Num() == Defaults.Items.Num()
+        && State.ReplenishActors.Num() == Defaults.ReplenishActors.Num();
+}
+
+bool FGameSaveCodec::Encode(const FCheckpointSnapshot& State, const FCheckpointSnapshot& Defaults, TArray<uint8>& OutBytes)
+{
+    using namespace GameSaveCodec;
+
+    OutBytes.Reset();
+    if (!MatchesLayout(State, Defaults))
+    {
+        return false;
+    }
+
+    FMemoryWriter Ar(OutBytes);
+
+    uint32 MagicValue = Magic;
+    uint16 Version = CurrentVersion;
+    uint32 LayoutHash = Defaults.LayoutHash;
+    Ar << MagicValue << Version << LayoutHash;
+
+    FVector PlayerLocation = State.PlayerTransform.GetLocation();
+    FQuat PlayerRotation = State.PlayerTransform.GetRotation();
+    FRotator ControlRotation = State.ControlRotation;
+    float Oxygen = State.Oxygen;
+    int32 CurrentPuzzleIndex = State.CurrentPuzzleIndex;
+    SerializeVector(Ar, PlayerLocation);
+    SerializeQuat(Ar, PlayerRotation);
+    SerializeRotator(Ar, ControlRotation);
+    Ar << Oxygen;
+    SerializeIndex(Ar, CurrentPuzzleIndex);
+
+    // Puzzles
+    TArray<int32, TInlineAllocator<16>> Changed;
+    for (int32 i = 0; i < State.Puzzles.Num(); ++i)
+    {
+        if (PuzzleDiffers(State.Puzzles[i], Defaults.Puzzles[i]))
+        {
+            Changed.Add(i);
+        }
+    }
+    int32 NumChanged = Changed.Num();
+    SerializeIndex(Ar, NumChanged);
+    for (int32 Index : Changed)
+    {
+        const FPuzzleCheckpoint& Puzzle = State.Puzzles[Index];
+        uint8 Flags = (Puzzle.bIsCompleted ? PuzzleCompleted : 0) | (Puzzle.bIsActive ? PuzzleActive : 0) | (Puzzle.bMachineFixed ? MachineFixed : 0);
+        float Completion = Puzzle.CompletionPercentage;
+        float Progress = Puzzle.MachineProgress;
+        SerializeIndex(Ar, Index);
+        Ar << Flags << Completion << Progress;
+    }
+
+    // Items
+    Changed.Reset();
+    for (int32 i = 0; i < State.Items.Num(); ++i)
+    {
+        if (TransformDiffers(State.Items[i].Transform, Defaults.Items[i].Transform))
+        {
+            Changed.Add(i);
+        }
+    }
+    NumChanged = Changed.Num();
+    SerializeIndex(Ar, NumChanged);
+    for (int32 Index : Changed)
+    {
+        FVector Location = State.Items[Index].Transform.GetLocation();
+        FQuat Rotation = State.Items[Index].Transform.GetRotation();
+        SerializeIndex(Ar, Index);
+        SerializeVector(Ar, Location);
+        SerializeQuat(Ar, Rotation);
+    }
+
+    // Replenish actors
+    Changed.Reset();
+    for (int32 i = 0; i < State.ReplenishActors.Num(); ++i)
+    {
+        if (State.ReplenishActors[i].bConsumed != Defaults.ReplenishActors[i].bConsumed)
+        {
+            Changed.Add(i);
+        }
+    }
+    NumChanged = Changed.Num();
+    SerializeIndex(Ar, NumChanged);
+    for (int32 Index : Changed)
+    {
+        SerializeIndex(Ar, Index);
+    }
+    return true;
+}
+
+bool FGameSaveCodec::Decode(const TArray<uint8>& Bytes, const FCheckpointSnapshot& Defaults, FCheckpointSnapshot& OutState)
+{
+    using namespace GameSaveCodec;
+
+    FMemoryReader Ar(Bytes);
+
+    uint32 MagicValue = 0;
+    uint16 Version = 0;
+    uint32 LayoutHash = 0;
+    Ar << MagicValue << Version << LayoutHash;
+    if (Ar.IsError() || MagicValue != Magic)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GameSave: Not a save file"));
+        return false;
+    }
+    if (Version > CurrentVersion)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GameSave: Save version %d is newer than supported version %d"), Version, CurrentVersion);
+        return false;
+    }
+    if (LayoutHash != Defaults.LayoutHash)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("GameSave: Save was made against a different level layout"));
+        return false;
+    }
+
+    OutState = Defaults;
+
+    FVector PlayerLocation;
+    FQuat PlayerRotation;
+    SerializeVector(Ar, PlayerLocation);
+    SerializeQuat(Ar, PlayerRotation);
+    SerializeRotator(Ar, OutState.ControlRotation);
+    Ar << OutState.Oxygen;
+    SerializeIndex(Ar, OutState.CurrentPuzzleIndex);
+    OutState.PlayerTransform = FTransform(PlayerRotation, PlayerLocation, Defaults.PlayerTransform.GetScale3D());
+
+    int32 NumChanged = 0;
+    SerializeIndex(Ar, NumChanged);
+    for (int32 i = 0; i < NumChanged && !Ar.IsError(); ++i)
+    {
+        int32 Index = 0;
+        uint8 Flags = 0;
+        float Completion = 0.0f;
+        float Progress = 0.0f;
+        SerializeIndex(Ar, Index);
+        Ar << Flags << Completion << Progress;
+        if (!OutState.Puzzles.IsValidIndex(Index))
+        {
+            return false;
+        }
+
+        FPuzzleCheckpoint& Puzzle = OutState.Puzzles[Index];
+        Puzzle.bIsCompleted = (Flags & PuzzleCompleted) != 0;
+        Puzzle.bIsActive = (Flags & PuzzleActive) != 0;
+        Puzzle.bMachineFixed = (Flags & MachineFixed) != 0;
+        Puzzle.CompletionPercentage = Completion;
+        Puzzle.MachineProgress = Progress;
+    }
+
+    SerializeIndex(Ar, NumChanged);
+    for (int32 i = 0; i < NumChanged && !Ar.IsError(); ++i)
+    {
+        int32 Index = 0;
+        FVector Location;
+        FQuat Rotation;
+        SerializeIndex(Ar, Index);
+        SerializeVector(Ar, Location);
+        SerializeQuat(Ar, Rotation);
+        if (!OutState.Items.IsValidIndex(Index))
+        {
+            return false;
+        }
+
+        FTransform& Transform = OutState.Items[Index].Transform;
+        Transform.SetLocation(Location);
+        Transform.SetRotation(Rotation);
+    }
+
+    SerializeIndex(Ar, NumChanged);
+    for (int32 i = 0; i < NumChanged && !Ar.IsError(); ++i)
+    {
+        int32 Index = 0;
+        SerializeIndex(Ar, Index);
+        if (!OutState.ReplenishActors.IsValidIndex(Index))
+        {
+            return false;
+        }
+        OutState.ReplenishActors[Index].bConsumed = !Defaults.ReplenishActors[Index].bConsumed;
+    }
+
+    OutState.bValid = !Ar.IsError();
+    return OutState.bValid;
+}
+
+namespace GameSaveCodec
+{
+    // Synthetic level with NumObjects items/puzzles/replenish actors, half of them changed
+    void BuildBenchmarkState(int32 NumObjects, FCheckpointSnapshot& OutDefaults, FCheckpointSnapshot& OutState)
+    {
+        FRandomStream Random(NumObjects);
+
+        OutDefaults = FCheckpointSnapshot();
+        OutDefaults.bValid = true;
+        OutDefaults.Oxygen = 100.0f;
+        OutDefaults.LayoutHash = static_cast<uint32>(NumObjects);
+        OutDefaults.Puzzles.SetNum(NumObjects);
+        OutDefaults.Items.SetNum(NumObjects);
+        OutDefaults.ReplenishActors.SetNum(NumObjects);
+        for (FItemCheckpoint& Item : OutDefaults.Items)
+        {
+            Item.Transform = FTransform(FRotator(0.0f, Random.FRandRange(-180.0f, 180.0f), 0.0f), Random.GetUnitVector() * 5000.0f);
+        }
+
+        OutState = OutDefaults;
+        OutState.Oxygen = 42.0f;
+        for (int32 i = 0; i < NumObjects; i += 2)
+        {
+            OutState.Puzzles[i].bIsCompleted = true;
+            OutState.Puzzles[i].CompletionPercentage = 100.0f;
+            OutState.Items[i].Transform.AddToTranslation(FVector(100.0f, 0.0f, 0.0f));
+            OutState.ReplenishActors[i].bConsumed = true;
+        }
+    }
+
+    void RunSaveBenchmark(const TArray<FString>& Args)
+    {
+        const int32 MaxObjects = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 4096;
+        const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100;
+
+        UE_LOG(LogTemp, Display, TEXT("SaveBenchmark: %d iterations per object count"), Iterations);
+        UE_LOG(LogTemp, Display, TEXT("SaveBenchmark: Objects, Bytes, EncodeMs, DecodeMs"));
+
+        TArray<uint8> Bytes;
+        FCheckpointSnapshot Defaults, State, Decoded;
+        for (int32 NumObjects = 16; NumObjects <= MaxObjects; NumObjects *= 2)
+        {
+            BuildBenchmarkState(NumObjects, Defaults, State);
+
+            const double EncodeStart = FPlatformTime::Seconds();
+            for (int32 i = 0; i < Iterations; ++i)
+            {
+                FGameSaveCodec::Encode(State, Defaults, Bytes);
+            }
+            const double EncodeMs = (FPlatformTime::Seconds() - EncodeStart) * 1000.0 / Iterations;
+
+            const double DecodeStart = FPlatformTime::Seconds();
+            for (int32 i = 0; i < Iterations; ++i)
+            {
+                FGameSaveCodec::Decode(Bytes, Defaults, Decoded);
+            }
+            const double DecodeMs = (FPlatformTime::Seconds() - DecodeStart) * 1000.0 / Iterations;
+
+            UE_LOG(LogTemp, Display, TEXT("SaveBenchmark: %d, %d, %.4f, %.4f"), NumObjects, Bytes.Num(), EncodeMs, DecodeMs);
+        }
+    }
+
+    static FAutoConsoleCommand SaveBenchmarkCommand(
+        TEXT("FirstPersonTest.SaveBenchmark"),
+        TEXT("Times save encode/decode against object count. Args: [MaxObjects=4096] [Iterations=100]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&RunSaveBenchmark));
+}
@@ -0,0 +1,98 @@
+#include "GameplayActorRegistry.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+
+void UGameplayActorRegistry::Deinitialize()
+{
+    ActorsByClass.Empty();
+    PendingListeners.Empty();
+
+    Super::Deinitialize();
+}
+
+UGameplayActorRegistry* UGameplayActorRegistry::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UGameplayActorRegistry>() : nullptr;
+}
+
+void UGameplayActorRegistry::RegisterActor(UClass* Key, AActor* Actor)
+{
+    if (!Key || !Actor)
+    {
+        return;
+    }
+
+    TArray<TWeakObjectPtr<AActor>>& Actors = ActorsByClass.FindOrAdd(Key);
+    Actors.RemoveAll([](const TWeakObjectPtr<AActor>& Entry) { return !Entry.IsValid(); });
+    Actors.AddUnique(Actor);
+
+    TArray<FPendingListener> Listeners;
+    if (PendingListeners.RemoveAndCopyValue(Key, Listeners))
+    {
+        for (FPendingListener& Pending : Listeners)
+        {
+            if (Pending.Listener.IsValid())
+            {
+                Pending.Callback(Actor);
+            }
+        }
+    }
+}
+
+void UGameplayActorRegistry::UnregisterActor(UClass* Key, AActor* Actor)
+{
+    if (TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByClass.Find(Key))
+    {
+        Actors->RemoveAll([Actor](const TWeakObjectPtr<AActor>& Entry) { return !Entry.IsValid() || Entry.Get() == Actor; });
+        if (Actors->Num() == 0)
+        {
+            ActorsByClass.Remove(Key);
+        }
+    }
+}
+
+AActor* UGameplayActorRegistry::FindActor(UClass* Key) const
+{
+    if (const TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByClass.Find(Key))
+    {
+        for (const TWeakObjectPtr<AActor>& Entry : *Actors)
+        {
+            if (AActor* Actor = Entry.Get())
+            {
+                return Actor;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void UGameplayActorRegistry::GetActors(UClass* Key, TArray<AActor*>& OutActors) const
+{
+    if (const TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByClass.Find(Key))
+    {
+        for (const TWeakObjectPtr<AActor>& Entry : *Actors)
+        {
+            if (AActor* Actor = Entry.Get())
+            {
+                OutActors.Add(Actor);
+            }
+        }
+    }
+}
+
+void UGameplayActorRegistry::WhenRegistered(UClass* Key, const UObject* Listener, TFunction<void(AActor*)> Callback)
+{
+    if (!Key || !Callback)
+    {
+        return;
+    }
+
+    if (AActor* Existing = FindActor(Key))
+    {
+        Callback(Existing);
+        return;
+    }
+
+    PendingListeners.FindOrAdd(Key).Add({ Listener, MoveTemp(Callback) });
+}
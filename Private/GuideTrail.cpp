@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "GuideTrail.h"
+#include "FirstPersonTest.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Materials/MaterialInstanceDynamic.h"
@@ -24,6 +25,11 @@ void AGuideTrail::BeginPlay()
     
     StartLocation = GetActorLocation();
     
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->RegisterActor(this, TickSignificance);
+    }
+    
     if (TrailEffect)
     {
         NiagaraComponent->SetAsset(TrailEffect);
@@ -71,6 +77,11 @@ void AGuideTrail::ActivateTrail()
         
         NiagaraComponent->SetVisibility(true);
         NiagaraComponent->Activate(true);
+        
+        if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+        {
+            Significance->SetPinned(this, true);
+        }
     }
 }
 
@@ -82,6 +93,11 @@ void AGuideTrail::DeactivateTrail()
         NiagaraComponent->Deactivate();
         NiagaraComponent->SetVisibility(false);
         ClearTrail();
+        
+        if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+        {
+            Significance->SetPinned(this, false);
+        }
     }
 }
 
@@ -124,6 +140,9 @@ void AGuideTrail::ClearTrail()
 
 void AGuideTrail::UpdateSplineMeshes()
 {
+    SCOPE_CYCLE_COUNTER(STAT_GuideTrailSplines);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AGuideTrail::UpdateSplineMeshes);
+
     ClearTrail();
     
     if (!TrailMesh)
@@ -0,0 +1,79 @@
+#include "HUDLayerLibrary.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/InvalidationBox.h"
+#include "Components/RetainerBox.h"
+#include "GameFramework/PlayerController.h"
+
+static const FName HUDLayerCacheName(TEXT("HUDLayerCache"));
+
+UUserWidget* UHUDLayerLibrary::CreateHUDLayer(APlayerController* OwningPlayer, TSubclassOf<UUserWidget> WidgetClass, const FHUDLayerSettings& Settings)
+{
+    if (!OwningPlayer || !WidgetClass)
+    {
+        return nullptr;
+    }
+
+    UUserWidget* Widget = CreateWidget<UUserWidget>(OwningPlayer, WidgetClass);
+    if (!Widget)
+    {
+        return nullptr;
+    }
+
+    // Must happen before AddToViewport builds the Slate hierarchy
+    WrapRootWidget(Widget, Settings);
+
+    Widget->AddToViewport(Settings.ZOrder);
+    return Widget;
+}
+
+void UHUDLayerLibrary::RequestHUDLayerRedraw(UUserWidget* Layer)
+{
+    if (!Layer || !Layer->WidgetTree)
+    {
+        return;
+    }
+
+    if (URetainerBox* Retainer = Cast<URetainerBox>(Layer->WidgetTree->RootWidget))
+    {
+        Retainer->RequestRender();
+    }
+    else if (UInvalidationBox* Invalidation = Cast<UInvalidationBox>(Layer->WidgetTree->RootWidget))
+    {
+        Invalidation->InvalidateCache();
+    }
+}
+
+void UHUDLayerLibrary::WrapRootWidget(UUserWidget* Widget, const FHUDLayerSettings& Settings)
+{
+    if (Settings.Caching == EHUDLayerCaching::None || !Widget->WidgetTree)
+    {
+        return;
+    }
+
+    UWidget* Content = Widget->WidgetTree->RootWidget;
+    if (!Content || Content->GetFName() == HUDLayerCacheName)
+    {
+        return;
+    }
+
+    if (Widget->GetCachedWidget().IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("HUDLayer: %s is already constructed, leaving it uncached"), *Widget->GetName());
+        return;
+    }
+
+    if (Settings.Caching == EHUDLayerCaching::Retainer)
+    {
+        URetainerBox* Retainer = Widget->WidgetTree->ConstructWidget<URetainerBox>(URetainerBox::StaticClass(), HUDLayerCacheName);
+        Retainer->SetRenderingPhase(0, FMath::Max(1, Settings.RedrawEveryNFrames));
+        Widget->WidgetTree->RootWidget = Retainer;
+        Retainer->AddChild(Content);
+    }
+    else
+    {
+        UInvalidationBox* Invalidation = Widget->WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), HUDLayerCacheName);
+        Invalidation->SetCanCache(true);
+        Widget->WidgetTree->RootWidget = Invalidation;
+        Invalidation->AddChild(Content);
+    }
+}
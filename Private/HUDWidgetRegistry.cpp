@@ -0,0 +1,94 @@
+#include "HUDWidgetRegistry.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+void UHUDWidgetRegistry::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &UHUDWidgetRegistry::OnWorldCleanup);
+}
+
+void UHUDWidgetRegistry::Deinitialize()
+{
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+    for (const TPair<UClass*, UUserWidget*>& Entry : WidgetsByClass)
+    {
+        if (IsValid(Entry.Value))
+        {
+            Entry.Value->RemoveFromParent();
+        }
+    }
+    WidgetsByClass.Empty();
+
+    Super::Deinitialize();
+}
+
+UHUDWidgetRegistry* UHUDWidgetRegistry::Get(const APlayerController* PlayerController)
+{
+    const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+    return LocalPlayer ? LocalPlayer->GetSubsystem<UHUDWidgetRegistry>() : nullptr;
+}
+
+void UHUDWidgetRegistry::RegisterWidget(UUserWidget* Widget)
+{
+    if (!Widget)
+    {
+        return;
+    }
+
+    UUserWidget*& Slot = WidgetsByClass.FindOrAdd(Widget->GetClass());
+    if (Slot && Slot != Widget && IsValid(Slot))
+    {
+        Slot->RemoveFromParent();
+    }
+    Slot = Widget;
+}
+
+void UHUDWidgetRegistry::UnregisterWidget(UUserWidget* Widget)
+{
+    if (!Widget)
+    {
+        return;
+    }
+
+    UUserWidget** Found = WidgetsByClass.Find(Widget->GetClass());
+    if (Found && *Found == Widget)
+    {
+        WidgetsByClass.Remove(Widget->GetClass());
+    }
+}
+
+UUserWidget* UHUDWidgetRegistry::FindWidget(TSubclassOf<UUserWidget> WidgetClass) const
+{
+    UUserWidget* const* Found = WidgetsByClass.Find(WidgetClass);
+    return Found && IsValid(*Found) ? *Found : nullptr;
+}
+
+void UHUDWidgetRegistry::ReleaseWidget(TSubclassOf<UUserWidget> WidgetClass)
+{
+    UUserWidget* Widget = nullptr;
+    if (WidgetsByClass.RemoveAndCopyValue(WidgetClass, Widget) && IsValid(Widget))
+    {
+        Widget->RemoveFromParent();
+    }
+}
+
+void UHUDWidgetRegistry::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    for (auto It = WidgetsByClass.CreateIterator(); It; ++It)
+    {
+        UUserWidget* Widget = It.Value();
+        if (!IsValid(Widget))
+        {
+            It.RemoveCurrent();
+        }
+        else if (Widget->GetWorld() == World)
+        {
+            Widget->RemoveFromParent();
+            It.RemoveCurrent();
+        }
+    }
+}
@@ -0,0 +1,291 @@
+#include "ImpactAudioSubsystem.h"
+#include "FirstPersonTest.h"
+#include "Components/AudioComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/PrimitiveComponent.h"
+#include "Sound/SoundBase.h"
+#include "Sound/SoundConcurrency.h"
+
+void UImpactAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Concurrency = ImpactConcurrency.IsNull() ? nullptr : ImpactConcurrency.LoadSynchronous();
+    Pending.Reserve(MaxImpactsPerFrame);
+}
+
+void UImpactAudioSubsystem::Deinitialize()
+{
+    for (UAudioComponent* Component : Pool)
+    {
+        if (IsValid(Component))
+        {
+            Component->Stop();
+            Component->DestroyComponent();
+        }
+    }
+    Pool.Empty();
+    PoolStartTimes.Empty();
+    Pending.Empty();
+    HitSources.Empty();
+    HitSourceIndex.Empty();
+
+    Super::Deinitialize();
+}
+
+UImpactAudioSubsystem* UImpactAudioSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UImpactAudioSubsystem>() : nullptr;
+}
+
+void UImpactAudioSubsystem::QueueImpact(USoundBase* Sound, const FVector& Location, float Impulse, float VolumeMultiplier, const AActor* Source)
+{
+    if (!Sound || MaxImpactsPerFrame <= 0)
+    {
+        return;
+    }
+
+    INC_DWORD_STAT(STAT_ImpactsQueued);
+
+    // Pending never holds more than MaxImpactsPerFrame entries, so these scans stay tiny
+    int32 WeakestIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < Pending.Num(); ++Index)
+    {
+        if (Source && Pending[Index].Source == Source)
+        {
+            // Both bodies of a contact, or several contacts of one body, report the same impact
+            if (Impulse > Pending[Index].Impulse)
+            {
+                Pending[Index] = { Sound, Location, Impulse, VolumeMultiplier, Source };
+            }
+            return;
+        }
+
+        if (WeakestIndex == INDEX_NONE || Pending[Index].Impulse < Pending[WeakestIndex].Impulse)
+        {
+            WeakestIndex = Index;
+        }
+    }
+
+    if (Pending.Num() < MaxImpactsPerFrame)
+    {
+        Pending.Add({ Sound, Location, Impulse, VolumeMultiplier, Source });
+    }
+    else if (Impulse > Pending[WeakestIndex].Impulse)
+    {
+        Pending[WeakestIndex] = { Sound, Location, Impulse, VolumeMultiplier, Source };
+    }
+}
+
+void UImpactAudioSubsystem::RegisterHitSource(UPrimitiveComponent* Component, float CullDistance)
+{
+    if (!Component)
+    {
+        return;
+    }
+
+    FHitSource* Source = nullptr;
+    if (const int32* Index = HitSourceIndex.Find(Component))
+    {
+        Source = &HitSources[*Index];
+    }
+    else
+    {
+        Source = &HitSources.AddDefaulted_GetRef();
+        Source->Key = Component;
+        Source->Component = Component;
+        Source->bNotifying = Component->BodyInstance.bNotifyRigidBodyCollision;
+        HitSourceIndex.Add(Component, HitSources.Num() - 1);
+    }
+    Source->CullDistanceSquared = FMath::Square(FMath::Max(CullDistance, 0.0f));
+
+    // Start audible; the round-robin turns it off if the listener turns out to be far away
+    SetNotifying(*Source, true);
+}
+
+void UImpactAudioSubsystem::UnregisterHitSource(UPrimitiveComponent* Component)
+{
+    if (const int32* Index = HitSourceIndex.Find(Component))
+    {
+        SetNotifying(HitSources[*Index], false);
+        RemoveHitSourceAt(*Index);
+    }
+}
+
+void UImpactAudioSubsystem::RemoveHitSourceAt(int32 Index)
+{
+    HitSourceIndex.Remove(HitSources[Index].Key);
+
+    HitSources.RemoveAtSwap(Index, 1, false);
+    if (HitSources.IsValidIndex(Index))
+    {
+        HitSourceIndex.Add(HitSources[Index].Key, Index);
+    }
+}
+
+void UImpactAudioSubsystem::SetNotifying(FHitSource& Source, bool bNotify)
+{
+    if (Source.bNotifying == bNotify)
+    {
+        return;
+    }
+
+    // Re-filters the body in the physics scene, hence the hysteresis around the cull distance
+    if (UPrimitiveComponent* Component = Source.Component.Get())
+    {
+        Component->SetNotifyRigidBodyCollision(bNotify);
+    }
+    Source.bNotifying = bNotify;
+}
+
+void UImpactAudioSubsystem::UpdateHitSources(const FVector& ListenerLocation)
+{
+    const float OffScale = FMath::Square(1.0f + HitNotifyHysteresis);
+
+    const int32 Budget = FMath::Min(HitSourcesEvaluatedPerFrame, HitSources.Num());
+    for (int32 i = 0; i < Budget && HitSources.Num() > 0; ++i)
+    {
+        if (NextHitSourceToEvaluate >= HitSources.Num())
+        {
+            NextHitSourceToEvaluate = 0;
+        }
+
+        FHitSource& Source = HitSources[NextHitSourceToEvaluate];
+        const UPrimitiveComponent* Component = Source.Component.Get();
+        if (!Component)
+        {
+            // Destroyed without unregistering; the swapped-in entry is evaluated next
+            RemoveHitSourceAt(NextHitSourceToEvaluate);
+            continue;
+        }
+
+        if (Source.CullDistanceSquared > 0.0f)
+        {
+            const float DistanceSquared = FVector::DistSquared(Component->GetComponentLocation(), ListenerLocation);
+            const float Limit = Source.CullDistanceSquared * (Source.bNotifying ? OffScale : 1.0f);
+            SetNotifying(Source, DistanceSquared <= Limit);
+        }
+        ++NextHitSourceToEvaluate;
+    }
+}
+
+void UImpactAudioSubsystem::Tick(float DeltaTime)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UImpactAudioSubsystem::Tick);
+
+    if (HitSources.Num() > 0)
+    {
+        if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
+        {
+            FVector ListenerLocation, FrontDir, RightDir;
+            PC->GetAudioListenerPosition(ListenerLocation, FrontDir, RightDir);
+            UpdateHitSources(ListenerLocation);
+        }
+    }
+
+    if (Pending.Num() == 0)
+    {
+        return;
+    }
+
+    // Strongest first, so they get the idle components before any have to be reused
+    Pending.Sort([](const FPendingImpact& A, const FPendingImpact& B) { return A.Impulse > B.Impulse; });
+
+    for (const FPendingImpact& Impact : Pending)
+    {
+        if (UAudioComponent* Component = AcquireComponent())
+        {
+            Component->SetWorldLocation(Impact.Location);
+            Component->SetSound(Impact.Sound);
+            Component->SetVolumeMultiplier(Impact.VolumeMultiplier);
+            Component->Play();
+            INC_DWORD_STAT(STAT_ImpactSoundsPlayed);
+        }
+    }
+
+    Pending.Reset();
+}
+
+UAudioComponent* UImpactAudioSubsystem::AcquireComponent()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+
+    int32 OldestIndex = INDEX_NONE;
+    for (int32 Index = 0; Index < Pool.Num(); ++Index)
+    {
+        if (!IsValid(Pool[Index]))
+        {
+            // Destroyed from outside the pool; replace it in place
+            Pool[Index] = CreatePooledComponent();
+            PoolStartTimes[Index] = Now;
+            return Pool[Index];
+        }
+
+        if (!Pool[Index]->IsPlaying())
+        {
+            PoolStartTimes[Index] = Now;
+            return Pool[Index];
+        }
+
+        if (OldestIndex == INDEX_NONE || PoolStartTimes[Index] < PoolStartTimes[OldestIndex])
+        {
+            OldestIndex = Index;
+        }
+    }
+
+    if (Pool.Num() < PoolSize)
+    {
+        UAudioComponent* Component = CreatePooledComponent();
+        if (Component)
+        {
+            Pool.Add(Component);
+            PoolStartTimes.Add(Now);
+        }
+        return Component;
+    }
+
+    if (OldestIndex != INDEX_NONE)
+    {
+        Pool[OldestIndex]->Stop();
+        PoolStartTimes[OldestIndex] = Now;
+        return Pool[OldestIndex];
+    }
+
+    return nullptr;
+}
+
+UAudioComponent* UImpactAudioSubsystem::CreatePooledComponent()
+{
+    AActor* Owner = GetWorld()->GetWorldSettings();
+    if (!Owner)
+    {
+        return nullptr;
+    }
+
+    UAudioComponent* Component = NewObject<UAudioComponent>(Owner);
+    // Not auto-destroyed, so the component outlives each sound and can be handed out again
+    Component->bAutoActivate = false;
+    Component->bAutoDestroy = false;
+    Component->bAllowSpatialization = true;
+    if (Concurrency)
+    {
+        Component->ConcurrencySet.Add(Concurrency);
+    }
+    Component->RegisterComponentWithWorld(GetWorld());
+    return Component;
+}
+
+TStatId UImpactAudioSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UImpactAudioSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UImpactAudioSubsystem::GetTickableTickType() const
+{
+    // The class default object must never tick
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
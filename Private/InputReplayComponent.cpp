@@ -0,0 +1,405 @@
+#include "InputReplayComponent.h"
+#include "MyFPSCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "TimerManager.h"
+
+namespace InputReplay
+{
+    enum EFrameFields : uint8
+    {
+        MoveForwardChanged = 1 << 0,
+        MoveRightChanged   = 1 << 1,
+        TurnChanged        = 1 << 2,
+        LookUpChanged      = 1 << 3,
+        HasPressed         = 1 << 4,
+        HasReleased        = 1 << 5,
+    };
+
+    // Stored as 32-bit floats regardless of the engine's vector precision
+    void SerializeVector(FArchive& Ar, FVector& Vector)
+    {
+        float X = Vector.X, Y = Vector.Y, Z = Vector.Z;
+        Ar << X << Y << Z;
+        Vector = FVector(X, Y, Z);
+    }
+
+    void SerializeRotator(FArchive& Ar, FRotator& Rotator)
+    {
+        float Pitch = Rotator.Pitch, Yaw = Rotator.Yaw, Roll = Rotator.Roll;
+        Ar << Pitch << Yaw << Roll;
+        Rotator = FRotator(Pitch, Yaw, Roll);
+    }
+
+    UInputReplayComponent* FindPlayerReplay(UWorld* World)
+    {
+        APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+        AMyFPSCharacter* Character = PC ? Cast<AMyFPSCharacter>(PC->GetPawn()) : nullptr;
+        return Character ? Character->GetInputReplay() : nullptr;
+    }
+
+    void ToggleRecording(const TArray<FString>& Args, UWorld* World)
+    {
+        if (UInputReplayComponent* Replay = FindPlayerReplay(World))
+        {
+            if (Replay->IsRecording())
+            {
+                Replay->StopRecording();
+            }
+            else
+            {
+                Replay->StartRecording(Args.Num() > 0 ? Args[0] : TEXT("Session"));
+            }
+        }
+    }
+
+    void ToggleReplay(const TArray<FString>& Args, UWorld* World)
+    {
+        if (UInputReplayComponent* Replay = FindPlayerReplay(World))
+        {
+            if (Replay->IsReplaying())
+            {
+                Replay->StopReplay();
+            }
+            else
+            {
+                Replay->StartReplay(Args.Num() > 0 ? Args[0] : TEXT("Session"));
+            }
+        }
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs RecordInputCommand(
+        TEXT("FirstPersonTest.RecordInput"),
+        TEXT("Starts recording the player's input, or stops and saves the recording. Args: [Name=Session]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ToggleRecording));
+
+    static FAutoConsoleCommandWithWorldAndArgs ReplayInputCommand(
+        TEXT("FirstPersonTest.ReplayInput"),
+        TEXT("Replays a recorded input session from its starting point, or stops the running replay. Args: [Name=Session]"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&ToggleReplay));
+}
+
+UInputReplayComponent::UInputReplayComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UInputReplayComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    FString Name;
+    if (FParse::Value(FCommandLine::Get(), TEXT("ReplayInput="), Name) || FParse::Value(FCommandLine::Get(), TEXT("RecordInput="), Name))
+    {
+        // Possession may not have happened yet this frame
+        GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UInputReplayComponent::StartFromCommandLine);
+    }
+}
+
+void UInputReplayComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StopRecording();
+    StopReplay();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UInputReplayComponent::StartFromCommandLine()
+{
+    AMyFPSCharacter* Character = GetCharacter();
+    if (!Character || !Character->IsPlayerControlled())
+    {
+        return;
+    }
+
+    FString Name;
+    if (FParse::Value(FCommandLine::Get(), TEXT("ReplayInput="), Name))
+    {
+        StartReplay(Name);
+    }
+    else if (FParse::Value(FCommandLine::Get(), TEXT("RecordInput="), Name))
+    {
+        StartRecording(Name);
+    }
+}
+
+AMyFPSCharacter* UInputReplayComponent::GetCharacter() const
+{
+    return Cast<AMyFPSCharacter>(GetOwner());
+}
+
+FString UInputReplayComponent::GetReplayPath(const FString& Name)
+{
+    return FPaths::ProjectSavedDir() / TEXT("InputReplays") / Name + TEXT(".fpinput");
+}
+
+bool UInputReplayComponent::StartRecording(const FString& Name)
+{
+    AMyFPSCharacter* Character = GetCharacter();
+    if (bRecording || bReplaying || !Character || !Character->GetController())
+    {
+        return false;
+    }
+
+    ActiveName = Name;
+    StartLocation = Character->GetActorLocation();
+    StartRotation = Character->GetController()->GetControlRotation();
+    Frames.Reset();
+
+    // Anything captured before this point belongs to no recorded frame
+    Character->ConsumeLiveInput();
+
+    bRecording = true;
+    Begin(FixedDeltaTime, true);
+
+    UE_LOG(LogTemp, Log, TEXT("InputReplay: recording '%s'"), *Name);
+    return true;
+}
+
+void UInputReplayComponent::StopRecording()
+{
+    if (!bRecording)
+    {
+        return;
+    }
+    bRecording = false;
+    End();
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 FileMagic = Magic;
+    uint16 Version = CurrentVersion;
+    float DeltaTime = FixedDeltaTime;
+    Writer << FileMagic << Version << DeltaTime;
+    InputReplay::SerializeVector(Writer, StartLocation);
+    InputReplay::SerializeRotator(Writer, StartRotation);
+
+    uint32 FrameCount = Frames.Num();
+    Writer.SerializeIntPacked(FrameCount);
+
+    FRecordedInputFrame Previous;
+    for (FRecordedInputFrame& Frame : Frames)
+    {
+        SerializeFrame(Writer, Frame, Previous);
+        Previous = Frame;
+    }
+
+    const FString Path = GetReplayPath(ActiveName);
+    if (FFileHelper::SaveArrayToFile(Bytes, *Path))
+    {
+        UE_LOG(LogTemp, Log, TEXT("InputReplay: saved %d frames (%d bytes) to %s"), Frames.Num(), Bytes.Num(), *Path);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("InputReplay: failed to write %s"), *Path);
+    }
+    Frames.Empty();
+}
+
+bool UInputReplayComponent::StartReplay(const FString& Name)
+{
+    AMyFPSCharacter* Character = GetCharacter();
+    if (bRecording || bReplaying || !Character || !Character->GetController())
+    {
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    const FString Path = GetReplayPath(Name);
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InputReplay: no recording at %s"), *Path);
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    uint32 FileMagic = 0;
+    uint16 Version = 0;
+    Reader << FileMagic << Version;
+    if (FileMagic != Magic || Version > CurrentVersion)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InputReplay: %s is not a supported recording"), *Path);
+        return false;
+    }
+
+    Reader << RecordedDeltaTime;
+    InputReplay::SerializeVector(Reader, StartLocation);
+    InputReplay::SerializeRotator(Reader, StartRotation);
+
+    uint32 FrameCount = 0;
+    Reader.SerializeIntPacked(FrameCount);
+
+    Frames.Reset(FrameCount);
+    FRecordedInputFrame Previous;
+    for (uint32 i = 0; i < FrameCount && !Reader.IsError(); ++i)
+    {
+        FRecordedInputFrame& Frame = Frames.AddDefaulted_GetRef();
+        SerializeFrame(Reader, Frame, Previous);
+        Previous = Frame;
+    }
+    if (Reader.IsError() || RecordedDeltaTime <= 0.0f)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InputReplay: %s is truncated or corrupt"), *Path);
+        Frames.Empty();
+        return false;
+    }
+
+    // Every replay starts from the exact state the recording started from
+    Character->SetActorLocation(StartLocation, false, nullptr, ETeleportType::TeleportPhysics);
+    Character->GetController()->SetControlRotation(StartRotation);
+    Character->GetCharacterMovement()->StopMovementImmediately();
+    Character->ConsumeLiveInput();
+
+    ActiveName = Name;
+    NextReplayFrame = 0;
+    bReplaying = true;
+    Begin(RecordedDeltaTime, false);
+
+    UE_LOG(LogTemp, Log, TEXT("InputReplay: replaying '%s' (%d frames)"), *Name, Frames.Num());
+    return true;
+}
+
+void UInputReplayComponent::StopReplay()
+{
+    if (!bReplaying)
+    {
+        return;
+    }
+    bReplaying = false;
+    End();
+    Frames.Empty();
+
+    UE_LOG(LogTemp, Log, TEXT("InputReplay: finished '%s'"), *ActiveName);
+    OnReplayFinished.Broadcast();
+}
+
+void UInputReplayComponent::Begin(float DeltaTime, bool bRealTime)
+{
+    bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+    PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+    FApp::SetFixedDeltaTime(DeltaTime);
+    FApp::SetUseFixedTimeStep(true);
+
+    // A fixed timestep alone runs the game as fast as frames come, so a recording on a fast machine
+    // would be played at many times normal speed. The engine's fixed frame rate waits out each frame.
+    bOwnsFixedFrameRate = bRealTime && GEngine;
+    if (bOwnsFixedFrameRate)
+    {
+        bPreviousUseFixedFrameRate = GEngine->bUseFixedFrameRate;
+        PreviousFixedFrameRate = GEngine->FixedFrameRate;
+        GEngine->bUseFixedFrameRate = true;
+        GEngine->FixedFrameRate = 1.0f / DeltaTime;
+    }
+
+    // Run before the controller processes input, which is where live input is handled too
+    if (AController* Controller = GetCharacter()->GetController())
+    {
+        Controller->PrimaryActorTick.AddPrerequisite(this, PrimaryComponentTick);
+        DependentController = Controller;
+    }
+
+    SetComponentTickEnabled(true);
+}
+
+void UInputReplayComponent::End()
+{
+    SetComponentTickEnabled(false);
+
+    if (AController* Controller = DependentController.Get())
+    {
+        Controller->PrimaryActorTick.RemovePrerequisite(this, PrimaryComponentTick);
+    }
+    DependentController.Reset();
+
+    FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+    FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+    if (bOwnsFixedFrameRate && GEngine)
+    {
+        GEngine->bUseFixedFrameRate = bPreviousUseFixedFrameRate;
+        GEngine->FixedFrameRate = PreviousFixedFrameRate;
+    }
+    bOwnsFixedFrameRate = false;
+}
+
+void UInputReplayComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    AMyFPSCharacter* Character = GetCharacter();
+    if (!Character)
+    {
+        return;
+    }
+
+    if (bRecording)
+    {
+        // The controller ticked after us last frame, so this is last frame's input
+        Frames.Add(Character->ConsumeLiveInput());
+    }
+    else if (bReplaying)
+    {
+        if (!Frames.IsValidIndex(NextReplayFrame))
+        {
+            StopReplay();
+            return;
+        }
+        Character->ApplyInputFrame(Frames[NextReplayFrame++]);
+    }
+}
+
+void UInputReplayComponent::SerializeFrame(FArchive& Ar, FRecordedInputFrame& Frame, const FRecordedInputFrame& Previous)
+{
+    using namespace InputReplay;
+
+    uint8 Fields = 0;
+    if (Ar.IsSaving())
+    {
+        Fields |= Frame.MoveForward != Previous.MoveForward ? MoveForwardChanged : 0;
+        Fields |= Frame.MoveRight != Previous.MoveRight ? MoveRightChanged : 0;
+        Fields |= Frame.Turn != Previous.Turn ? TurnChanged : 0;
+        Fields |= Frame.LookUp != Previous.LookUp ? LookUpChanged : 0;
+        Fields |= Frame.Pressed != EReplayInputAction::None ? HasPressed : 0;
+        Fields |= Frame.Released != EReplayInputAction::None ? HasReleased : 0;
+    }
+    else
+    {
+        // Axes carry over from the previous frame; actions are per-frame events
+        Frame = Previous;
+        Frame.Pressed = EReplayInputAction::None;
+        Frame.Released = EReplayInputAction::None;
+    }
+
+    Ar << Fields;
+
+    if (Fields & MoveForwardChanged) { Ar << Frame.MoveForward; }
+    if (Fields & MoveRightChanged)   { Ar << Frame.MoveRight; }
+    if (Fields & TurnChanged)        { Ar << Frame.Turn; }
+    if (Fields & LookUpChanged)      { Ar << Frame.LookUp; }
+
+    if (Fields & HasPressed)
+    {
+        uint8 Bits = static_cast<uint8>(Frame.Pressed);
+        Ar << Bits;
+        Frame.Pressed = static_cast<EReplayInputAction>(Bits);
+    }
+    if (Fields & HasReleased)
+    {
+        uint8 Bits = static_cast<uint8>(Frame.Released);
+        Ar << Bits;
+        Frame.Released = static_cast<EReplayInputAction>(Bits);
+    }
+}
@@ -1,11 +1,14 @@
 ﻿#include "InteractManager.h"
+#include "FirstPersonTest.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/Character.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/TextBlock.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
-#include "P_FixableMachine.h" 
+#include "GameplayActorRegistry.h"
+#include "InteractableDispatch.h"
+#include "InteractableIndexSubsystem.h"
 
 AInteractManager::AInteractManager()
 {
@@ -20,6 +23,21 @@ void AInteractManager::BeginPlay()
     {
         PromptWidget->SetVisibility(ESlateVisibility::Hidden);
     }
+
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Register<AInteractManager>(this);
+    }
+}
+
+void AInteractManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Unregister<AInteractManager>(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AInteractManager::Tick(float DeltaTime)
@@ -28,12 +46,15 @@ void AInteractManager::Tick(float DeltaTime)
 
     PerformInteractionRaycast();
     
-    if (bIsInteracting && CurrentInteractable.GetObject())
+    if (ActiveHoldTarget)
     {
-        AP_FixableMachine* Machine = Cast<AP_FixableMachine>(CurrentInteractable.GetObject());
-        if (Machine && !Machine->IsFixed() && !Machine->IsBeingFixed())
+        if (ActiveHoldObject.IsValid())
+        {
+            ActiveHoldTarget->TickHold(PlayerCharacter, DeltaTime);
+        }
+        else
         {
-            CurrentInteractable->Execute_Interact(CurrentInteractable.GetObject(), PlayerCharacter);
+            ActiveHoldTarget = nullptr;
         }
     }
 }
@@ -69,38 +90,80 @@ void AInteractManager::StartInteract()
     if (IsLookingAtInteractable())
     {
         bIsInteracting = true;
-        CurrentInteractable->Execute_Interact(CurrentInteractable.GetObject(), PlayerCharacter);
+        if (FocusedHoldTarget)
+        {
+            BeginActiveHold();
+        }
+        else
+        {
+            FInteractableDispatch::Interact(CurrentInteractable.GetObject(), PlayerCharacter);
+        }
     }
 }
 
 void AInteractManager::StopInteract()
 {
     bIsInteracting = false;
-    
-    if (CurrentInteractable.GetObject())
+    EndActiveHold();
+}
+
+void AInteractManager::TryInteract()
+{
+    if (IsLookingAtInteractable() && !FocusedHoldTarget)
     {
-        AP_FixableMachine* Machine = Cast<AP_FixableMachine>(CurrentInteractable.GetObject());
-        if (Machine && Machine->IsBeingFixed() && !Machine->IsFixed())
-        {
-            Machine->StopFixing();
-        }
+        FInteractableDispatch::Interact(CurrentInteractable.GetObject(), PlayerCharacter);
     }
 }
 
-void AInteractManager::TryInteract()
+void AInteractManager::SetFocus(const TScriptInterface<IInteractable>& NewInteractable)
 {
-    if (IsLookingAtInteractable())
+    EndActiveHold();
+
+    CurrentInteractable = NewInteractable;
+
+    // Blueprint-only implementations have no native interface pointer and never hold
+    IInteractable* Native = CurrentInteractable.GetInterface();
+    FocusedHoldTarget = Native && Native->SupportsHold() ? Native : nullptr;
+
+    // Sweeping onto a holdable while the key is still down starts holding it
+    if (bIsInteracting && FocusedHoldTarget)
+    {
+        BeginActiveHold();
+    }
+}
+
+void AInteractManager::BeginActiveHold()
+{
+    if (ActiveHoldTarget || !FocusedHoldTarget)
     {
-        AP_FixableMachine* Machine = Cast<AP_FixableMachine>(CurrentInteractable.GetObject());
-        if (!Machine)
+        return;
+    }
+
+    ActiveHoldTarget = FocusedHoldTarget;
+    ActiveHoldObject = CurrentInteractable.GetObject();
+    ActiveHoldTarget->BeginHold(PlayerCharacter);
+}
+
+void AInteractManager::EndActiveHold()
+{
+    if (ActiveHoldTarget)
+    {
+        IInteractable* Target = ActiveHoldTarget;
+        ActiveHoldTarget = nullptr;
+        if (ActiveHoldObject.IsValid())
         {
-            CurrentInteractable->Execute_Interact(CurrentInteractable.GetObject(), PlayerCharacter);
+            Target->EndHold(PlayerCharacter);
         }
     }
+    ActiveHoldObject = nullptr;
 }
 
 void AInteractManager::PerformInteractionRaycast()
 {
+    CSV_SCOPED_TIMING_STAT(Interaction, FocusQuery);
+    SCOPE_CYCLE_COUNTER(STAT_InteractionRaycast);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AInteractManager::PerformInteractionRaycast);
+
     if (!PlayerController || !PlayerCharacter)
     {
         return;
@@ -111,7 +174,85 @@ void AInteractManager::PerformInteractionRaycast()
     PlayerController->GetPlayerViewPoint(CameraLocation, CameraRotation);
 
     FVector CameraForward = CameraRotation.Vector();
-    FVector RayEnd = CameraLocation + (CameraForward * InteractionRange);
+
+    AActor* HitActor = nullptr;
+    UInteractableIndexSubsystem* Index = FocusMode == EInteractionFocusMode::Proximity ? UInteractableIndexSubsystem::Get(this) : nullptr;
+    if (Index)
+    {
+        TArray<FInteractableCandidate> Candidates;
+        Index->QueryCone(CameraLocation, CameraForward, InteractionRange, FocusConeHalfAngle, Candidates);
+
+        // Candidates that cannot be used (a fixed machine, a spent replenish) never take focus, so they
+        // cannot shadow a usable one next to them. A trace confirms the best remaining candidate is not
+        // behind a wall; a usable interactable it hits instead (something nearer on the same line) wins.
+        int32 TracesLeft = MaxFocusTraces;
+        for (const FInteractableCandidate& Candidate : Candidates)
+        {
+            if (!FInteractableDispatch::CanInteract(Candidate.Actor))
+            {
+                continue;
+            }
+            if (TracesLeft-- <= 0)
+            {
+                break;
+            }
+
+            bool bBlocked = false;
+            AActor* TracedActor = TraceForInteractable(CameraLocation, Candidate.Center, bBlocked);
+            if (TracedActor && FInteractableDispatch::CanInteract(TracedActor))
+            {
+                HitActor = TracedActor;
+                break;
+            }
+            if (!TracedActor && !bBlocked)
+            {
+                HitActor = Candidate.Actor;
+                break;
+            }
+        }
+    }
+    else
+    {
+        bool bBlocked = false;
+        HitActor = TraceForInteractable(CameraLocation, CameraLocation + (CameraForward * InteractionRange), bBlocked);
+    }
+
+    if (CurrentInteractable.GetObject() != nullptr && !HitActor)
+    {
+        FInteractableDispatch::OnUnhighlight(CurrentInteractable.GetObject());
+        SetFocus(nullptr);
+        UpdatePromptVisibility(false);
+    }
+
+    if (HitActor && HitActor != CurrentInteractable.GetObject())
+    {
+        if (CurrentInteractable.GetObject() != nullptr)
+        {
+            FInteractableDispatch::OnUnhighlight(CurrentInteractable.GetObject());
+        }
+
+        if (FInteractableDispatch::CanInteract(HitActor))
+        {
+            TScriptInterface<IInteractable> NewInteractable;
+            NewInteractable.SetObject(HitActor);
+            NewInteractable.SetInterface(Cast<IInteractable>(HitActor));
+
+            SetFocus(NewInteractable);
+            FInteractableDispatch::OnHighlight(HitActor);
+            UpdatePromptVisibility(true, FInteractableDispatch::GetInteractionText(HitActor));
+        }
+        else
+        {
+            SetFocus(nullptr);
+            UpdatePromptVisibility(false);
+        }
+    }
+}
+
+AActor* AInteractManager::TraceForInteractable(const FVector& Start, const FVector& End, bool& bOutBlocked)
+{
+    ++TraceCount;
+    INC_DWORD_STAT(STAT_GameplayTraces);
 
     FHitResult HitResult;
     FCollisionQueryParams QueryParams;
@@ -120,8 +261,8 @@ void AInteractManager::PerformInteractionRaycast()
 
     bool bHit = GetWorld()->LineTraceSingleByChannel(
         HitResult,
-        CameraLocation,
-        RayEnd,
+        Start,
+        End,
         ECC_Visibility,
         QueryParams
     );
@@ -130,8 +271,8 @@ void AInteractManager::PerformInteractionRaycast()
     {
         DrawDebugLine(
             GetWorld(),
-            CameraLocation,
-            bHit ? HitResult.ImpactPoint : RayEnd,
+            Start,
+            bHit ? HitResult.ImpactPoint : End,
             bHit ? FColor::Green : FColor::Red,
             false,
             0.1f,
@@ -140,44 +281,19 @@ void AInteractManager::PerformInteractionRaycast()
         );
     }
 
-    if (CurrentInteractable.GetObject() != nullptr && 
-        (!bHit || !HitResult.GetActor() || !HitResult.GetActor()->GetClass()->ImplementsInterface(UInteractable::StaticClass())))
+    AActor* HitActor = bHit ? HitResult.GetActor() : nullptr;
+    bOutBlocked = bHit;
+    if (HitActor && !FInteractableDispatch::Implements(HitActor->GetClass()))
     {
-        CurrentInteractable->Execute_OnUnhighlight(CurrentInteractable.GetObject());
-        CurrentInteractable = nullptr;
-        UpdatePromptVisibility(false);
-    }
-
-    if (bHit && HitResult.GetActor() && HitResult.GetActor()->GetClass()->ImplementsInterface(UInteractable::StaticClass()))
-    {
-        TScriptInterface<IInteractable> NewInteractable;
-        NewInteractable.SetObject(HitResult.GetActor());
-        NewInteractable.SetInterface(Cast<IInteractable>(HitResult.GetActor()));
-
-        if (NewInteractable.GetObject() != CurrentInteractable.GetObject())
-        {
-            if (CurrentInteractable.GetObject() != nullptr)
-            {
-                CurrentInteractable->Execute_OnUnhighlight(CurrentInteractable.GetObject());
-            }
-
-            if (NewInteractable->Execute_CanInteract(NewInteractable.GetObject()))
-            {
-                CurrentInteractable = NewInteractable;
-                CurrentInteractable->Execute_OnHighlight(CurrentInteractable.GetObject());
-                UpdatePromptVisibility(true, CurrentInteractable->Execute_GetInteractionText(CurrentInteractable.GetObject()));
-            }
-            else
-            {
-                CurrentInteractable = nullptr;
-                UpdatePromptVisibility(false);
-            }
-        }
+        HitActor = nullptr;
     }
+    return HitActor;
 }
 
 void AInteractManager::UpdatePromptVisibility(bool bVisible, const FText& Text)
 {
+    CSV_SCOPED_TIMING_STAT(GameplayUI, InteractPrompt);
+
     if (PromptWidget && PromptText)
     {
         if (bVisible)
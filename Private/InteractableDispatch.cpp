@@ -0,0 +1,140 @@
+#include "InteractableDispatch.h"
+#include "IInteractable.h"
+#include "UObject/Class.h"
+#include "UObject/ObjectKey.h"
+
+namespace InteractableDispatch
+{
+    enum EClassFlags : uint8
+    {
+        ImplementsInterface = 1 << 0,
+        NativeCanInteract   = 1 << 1,
+        NativeText          = 1 << 2,
+        NativeHighlight     = 1 << 3,
+        NativeUnhighlight   = 1 << 4,
+        NativeInteract      = 1 << 5,
+    };
+
+    struct FClassEntry
+    {
+        uint8 Flags = 0;
+
+        // Offset of the IInteractable subobject, or INDEX_NONE for Blueprint-only implementations
+        int32 InterfaceOffset = INDEX_NONE;
+    };
+
+    // Keyed by TObjectKey so a recompiled or reinstanced Blueprint class never matches a stale entry
+    TMap<TObjectKey<UClass>, FClassEntry> EntriesByClass;
+
+    int32 FindNativeInterfaceOffset(const UClass* Class)
+    {
+        for (const UClass* It = Class; It; It = It->GetSuperClass())
+        {
+            for (const FImplementedInterface& Interface : It->Interfaces)
+            {
+                if (!Interface.bImplementedByK2 && Interface.Class && Interface.Class->IsChildOf(UInteractable::StaticClass()))
+                {
+                    return Interface.PointerOffset;
+                }
+            }
+        }
+        return INDEX_NONE;
+    }
+
+    // A Blueprint override replaces the native UFunction with a script one, which drops FUNC_Native
+    bool IsNativeEvent(const UClass* Class, FName EventName)
+    {
+        const UFunction* Function = Class->FindFunctionByName(EventName);
+        return Function && Function->HasAnyFunctionFlags(FUNC_Native);
+    }
+
+    const FClassEntry& GetEntry(const UClass* Class)
+    {
+        if (const FClassEntry* Cached = EntriesByClass.Find(Class))
+        {
+            return *Cached;
+        }
+
+        FClassEntry Entry;
+        if (Class->ImplementsInterface(UInteractable::StaticClass()))
+        {
+            Entry.Flags |= ImplementsInterface;
+            Entry.InterfaceOffset = FindNativeInterfaceOffset(Class);
+
+            if (Entry.InterfaceOffset != INDEX_NONE)
+            {
+                Entry.Flags |= IsNativeEvent(Class, GET_FUNCTION_NAME_CHECKED(IInteractable, CanInteract)) ? NativeCanInteract : 0;
+                Entry.Flags |= IsNativeEvent(Class, GET_FUNCTION_NAME_CHECKED(IInteractable, GetInteractionText)) ? NativeText : 0;
+                Entry.Flags |= IsNativeEvent(Class, GET_FUNCTION_NAME_CHECKED(IInteractable, OnHighlight)) ? NativeHighlight : 0;
+                Entry.Flags |= IsNativeEvent(Class, GET_FUNCTION_NAME_CHECKED(IInteractable, OnUnhighlight)) ? NativeUnhighlight : 0;
+                Entry.Flags |= IsNativeEvent(Class, GET_FUNCTION_NAME_CHECKED(IInteractable, Interact)) ? NativeInteract : 0;
+            }
+        }
+
+        return EntriesByClass.Add(Class, Entry);
+    }
+
+    // Returns the native interface if Flag is set for the object's class, otherwise null
+    IInteractable* GetNative(UObject* Object, EClassFlags Flag)
+    {
+        const FClassEntry& Entry = GetEntry(Object->GetClass());
+        if ((Entry.Flags & Flag) == 0)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<IInteractable*>(reinterpret_cast<uint8*>(Object) + Entry.InterfaceOffset);
+    }
+}
+
+bool FInteractableDispatch::Implements(const UClass* Class)
+{
+    return Class && (InteractableDispatch::GetEntry(Class).Flags & InteractableDispatch::ImplementsInterface) != 0;
+}
+
+bool FInteractableDispatch::CanInteract(UObject* Object)
+{
+    if (IInteractable* Native = InteractableDispatch::GetNative(Object, InteractableDispatch::NativeCanInteract))
+    {
+        return Native->CanInteract_Implementation();
+    }
+    return IInteractable::Execute_CanInteract(Object);
+}
+
+FText FInteractableDispatch::GetInteractionText(UObject* Object)
+{
+    if (IInteractable* Native = InteractableDispatch::GetNative(Object, InteractableDispatch::NativeText))
+    {
+        return Native->GetInteractionText_Implementation();
+    }
+    return IInteractable::Execute_GetInteractionText(Object);
+}
+
+void FInteractableDispatch::OnHighlight(UObject* Object)
+{
+    if (IInteractable* Native = InteractableDispatch::GetNative(Object, InteractableDispatch::NativeHighlight))
+    {
+        Native->OnHighlight_Implementation();
+        return;
+    }
+    IInteractable::Execute_OnHighlight(Object);
+}
+
+void FInteractableDispatch::OnUnhighlight(UObject* Object)
+{
+    if (IInteractable* Native = InteractableDispatch::GetNative(Object, InteractableDispatch::NativeUnhighlight))
+    {
+        Native->OnUnhighlight_Implementation();
+        return;
+    }
+    IInteractable::Execute_OnUnhighlight(Object);
+}
+
+void FInteractableDispatch::Interact(UObject* Object, AActor* Interactor)
+{
+    if (IInteractable* Native = InteractableDispatch::GetNative(Object, InteractableDispatch::NativeInteract))
+    {
+        Native->Interact_Implementation(Interactor);
+        return;
+    }
+    IInteractable::Execute_Interact(Object, Interactor);
+}
@@ -0,0 +1,255 @@
+#include "InteractableIndexSubsystem.h"
+#include "InteractableDispatch.h"
+#include "Components/SceneComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+void UInteractableIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    if (UWorld* World = GetWorld())
+    {
+        ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UInteractableIndexSubsystem::OnActorSpawned));
+    }
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UInteractableIndexSubsystem::OnLevelAdded);
+}
+
+void UInteractableIndexSubsystem::Deinitialize()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    }
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+
+    while (Entries.Num() > 0)
+    {
+        RemoveAt(Entries.Num() - 1);
+    }
+
+    Super::Deinitialize();
+}
+
+void UInteractableIndexSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Everything placed in the persistent level and any level already streamed in
+    for (TActorIterator<AActor> It(&InWorld); It; ++It)
+    {
+        RegisterActor(*It);
+    }
+}
+
+UInteractableIndexSubsystem* UInteractableIndexSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UInteractableIndexSubsystem>() : nullptr;
+}
+
+void UInteractableIndexSubsystem::RegisterActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || IndexByActor.Contains(Actor) || !FInteractableDispatch::Implements(Actor->GetClass()))
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Key = Actor;
+    Entry.Actor = Actor;
+    Entry.Root = Actor->GetRootComponent();
+    IndexByActor.Add(Actor, Entries.Num() - 1);
+
+    UpdateEntry(Entry);
+    Cells.FindOrAdd(Entry.Cell).Add(Actor);
+
+    // Static roots never move, so only movable ones pay for a transform callback
+    if (USceneComponent* Root = Entry.Root.Get())
+    {
+        if (Root->Mobility != EComponentMobility::Static)
+        {
+            Entry.MovedHandle = Root->TransformUpdated.AddUObject(this, &UInteractableIndexSubsystem::OnRootMoved);
+        }
+    }
+
+    Actor->OnEndPlay.AddUniqueDynamic(this, &UInteractableIndexSubsystem::OnActorEndPlay);
+}
+
+void UInteractableIndexSubsystem::UnregisterActor(AActor* Actor)
+{
+    if (const int32* Index = IndexByActor.Find(Actor))
+    {
+        RemoveAt(*Index);
+    }
+}
+
+void UInteractableIndexSubsystem::RemoveAt(int32 Index)
+{
+    FEntry& Entry = Entries[Index];
+
+    if (USceneComponent* Root = Entry.Root.Get())
+    {
+        Root->TransformUpdated.Remove(Entry.MovedHandle);
+    }
+    if (AActor* Actor = Entry.Actor.Get())
+    {
+        Actor->OnEndPlay.RemoveDynamic(this, &UInteractableIndexSubsystem::OnActorEndPlay);
+    }
+
+    if (TArray<const AActor*>* Cell = Cells.Find(Entry.Cell))
+    {
+        Cell->RemoveSingleSwap(Entry.Key, false);
+        if (Cell->Num() == 0)
+        {
+            Cells.Remove(Entry.Cell);
+        }
+    }
+
+    IndexByActor.Remove(Entry.Key);
+    Entries.RemoveAtSwap(Index, 1, false);
+    if (Entries.IsValidIndex(Index))
+    {
+        IndexByActor.Add(Entries[Index].Key, Index);
+    }
+}
+
+FIntVector UInteractableIndexSubsystem::GetCell(const FVector& Location) const
+{
+    return FIntVector(
+        FMath::FloorToInt(Location.X / CellSize),
+        FMath::FloorToInt(Location.Y / CellSize),
+        FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UInteractableIndexSubsystem::UpdateEntry(FEntry& Entry)
+{
+    // The root's cached bounds are already up to date after a move; no need to walk every component
+    if (const USceneComponent* Root = Entry.Root.Get())
+    {
+        Entry.Center = Root->Bounds.Origin;
+        Entry.Radius = Root->Bounds.SphereRadius;
+    }
+    else if (const AActor* Actor = Entry.Actor.Get())
+    {
+        Entry.Center = Actor->GetActorLocation();
+        Entry.Radius = 0.0f;
+    }
+    Entry.Cell = GetCell(Entry.Center);
+}
+
+void UInteractableIndexSubsystem::OnRootMoved(USceneComponent* Root, EUpdateTransformFlags Flags, ETeleportType Teleport)
+{
+    const int32* Index = Root ? IndexByActor.Find(Root->GetOwner()) : nullptr;
+    if (!Index)
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries[*Index];
+    const FIntVector OldCell = Entry.Cell;
+    UpdateEntry(Entry);
+
+    if (Entry.Cell != OldCell)
+    {
+        if (TArray<const AActor*>* Cell = Cells.Find(OldCell))
+        {
+            Cell->RemoveSingleSwap(Entry.Key, false);
+            if (Cell->Num() == 0)
+            {
+                Cells.Remove(OldCell);
+            }
+        }
+        Cells.FindOrAdd(Entry.Cell).Add(Entry.Key);
+    }
+}
+
+void UInteractableIndexSubsystem::OnActorSpawned(AActor* Actor)
+{
+    RegisterActor(Actor);
+}
+
+void UInteractableIndexSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+    if (World != GetWorld() || !Level)
+    {
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        RegisterActor(Actor);
+    }
+}
+
+void UInteractableIndexSubsystem::OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+    UnregisterActor(Actor);
+}
+
+void UInteractableIndexSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, TArray<FInteractableCandidate>& OutCandidates) const
+{
+    OutCandidates.Reset();
+    if (Entries.Num() == 0 || Range <= 0.0f)
+    {
+        return;
+    }
+
+    const float HalfAngle = FMath::DegreesToRadians(HalfAngleDegrees);
+    const FIntVector MinCell = GetCell(Origin - FVector(Range));
+    const FIntVector MaxCell = GetCell(Origin + FVector(Range));
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+            {
+                const TArray<const AActor*>* Cell = Cells.Find(FIntVector(X, Y, Z));
+                if (!Cell)
+                {
+                    continue;
+                }
+
+                for (const AActor* Key : *Cell)
+                {
+                    const FEntry& Entry = Entries[IndexByActor.FindChecked(Key)];
+                    AActor* Actor = Entry.Actor.Get();
+                    if (!Actor)
+                    {
+                        continue;
+                    }
+
+                    const FVector ToCenter = Entry.Center - Origin;
+                    const float Distance = ToCenter.Size();
+                    if (Distance - Entry.Radius > Range)
+                    {
+                        continue;
+                    }
+
+                    // Angle from the view direction to the nearest edge of the bounds sphere
+                    float Angle = 0.0f;
+                    if (Distance > Entry.Radius)
+                    {
+                        const float CenterAngle = FMath::Acos(FMath::Clamp((ToCenter / Distance) | Direction, -1.0f, 1.0f));
+                        Angle = FMath::Max(0.0f, CenterAngle - FMath::Asin(Entry.Radius / Distance));
+                    }
+                    if (Angle > HalfAngle)
+                    {
+                        continue;
+                    }
+
+                    FInteractableCandidate& Candidate = OutCandidates.AddDefaulted_GetRef();
+                    Candidate.Actor = Actor;
+                    Candidate.Center = Entry.Center;
+                    Candidate.Score = AngleWeight * (1.0f - Angle / FMath::Max(HalfAngle, KINDA_SMALL_NUMBER))
+                        + (1.0f - FMath::Clamp(Distance / Range, 0.0f, 1.0f));
+                }
+            }
+        }
+    }
+
+    OutCandidates.Sort([](const FInteractableCandidate& A, const FInteractableCandidate& B) { return A.Score > B.Score; });
+}
@@ -0,0 +1,492 @@
+#include "InteractionBenchmarkSubsystem.h"
+#include "GameplayActorRegistry.h"
+#include "TickSignificanceSubsystem.h"
+#include "InteractManager.h"
+#include "MyFPSCharacter.h"
+#include "PickableItem.h"
+#include "P_FixableMachine.h"
+#include "OxygenReplenishActor.h"
+#include "WheepingAngle.h"
+#include "DialogueTrigger.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "FirstPersonTest.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+
+namespace InteractionBenchmark
+{
+    void RunFromConsole(const TArray<FString>& Args, UWorld* World)
+    {
+        if (UInteractionBenchmarkSubsystem* Benchmark = UInteractionBenchmarkSubsystem::Get(World))
+        {
+            if (Benchmark->IsRunning())
+            {
+                Benchmark->StopBenchmark();
+            }
+            else
+            {
+                Benchmark->StartBenchmark(false);
+            }
+        }
+    }
+
+    static FAutoConsoleCommandWithWorldAndArgs InteractionBenchmarkCommand(
+        TEXT("FirstPersonTest.InteractionBenchmark"),
+        TEXT("Starts the interaction benchmark in the current map, or stops it and writes the CSV if it is running."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunFromConsole));
+}
+
+void UInteractionBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (!InWorld.IsGameWorld())
+    {
+        return;
+    }
+
+    FString MapList;
+    if (FParse::Value(FCommandLine::Get(), TEXT("InteractionBenchmarkMaps="), MapList, false))
+    {
+        MapList.ParseIntoArray(SweepMaps, TEXT("+"));
+
+        // The sweep position travels with the map URL; without it we are still in the startup map
+        const TCHAR* MapIndexOption = InWorld.URL.GetOption(TEXT("BenchmarkMap="), nullptr);
+        if (!MapIndexOption)
+        {
+            AdvanceMapSweep(true);
+            return;
+        }
+        SweepMapIndex = FCString::Atoi(MapIndexOption);
+        bSweepFailed = InWorld.URL.HasOption(TEXT("BenchmarkFailed"));
+        bStartPending = true;
+        bQuitOnFinish = true;
+    }
+    else if (FParse::Param(FCommandLine::Get(), TEXT("InteractionBenchmark")))
+    {
+        bStartPending = true;
+        bQuitOnFinish = true;
+    }
+}
+
+void UInteractionBenchmarkSubsystem::Deinitialize()
+{
+    if (bRunning)
+    {
+        // The world is going away; record what we have but do not travel or exit from here
+        SweepMaps.Reset();
+        bQuitOnFinish = false;
+        StopBenchmark();
+    }
+
+    Super::Deinitialize();
+}
+
+UInteractionBenchmarkSubsystem* UInteractionBenchmarkSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UInteractionBenchmarkSubsystem>() : nullptr;
+}
+
+void UInteractionBenchmarkSubsystem::StartBenchmark(bool bQuitWhenDone)
+{
+    UWorld* World = GetWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    if (bRunning || !PC || !PC->GetPawn())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InteractionBenchmark: needs a possessed player pawn and no run in progress"));
+        return;
+    }
+
+    bRunning = true;
+    bHasResult = false;
+    bQuitOnFinish = bQuitWhenDone;
+    SimulatedTime = 0.0f;
+    FramesRun = 0;
+    Samples.Reset();
+    PathCenter = PC->GetPawn()->GetActorLocation();
+    LastTraceCount = GetInteractionTraceCount();
+
+    // Fixed timestep keeps the path and every actor's simulation identical between runs
+    bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+    PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+    FApp::SetFixedDeltaTime(FixedDeltaTime);
+    FApp::SetUseFixedTimeStep(true);
+
+#if CSV_PROFILER
+    // Capture the run unless one was already started (e.g. by -csvCaptureFrames)
+    if (!FCsvProfiler::Get()->IsCapturing())
+    {
+        FCsvProfiler::Get()->BeginCapture();
+        bOwnsCsvCapture = true;
+    }
+#endif
+
+    FRandomStream Random(RandomSeed);
+    SpawnPopulation(PickableItemClass, PickableItemCount, Random);
+    SpawnPopulation(FixableMachineClass, FixableMachineCount, Random);
+    SpawnPopulation(OxygenReplenishClass, OxygenReplenishCount, Random);
+    SpawnPopulation(WheepingAngleClass, WheepingAngleCount, Random);
+    SpawnPopulation(DialogueTriggerClass, DialogueTriggerCount, Random);
+
+    if (!InputReplayName.IsEmpty())
+    {
+        AMyFPSCharacter* Character = Cast<AMyFPSCharacter>(PC->GetPawn());
+        UInputReplayComponent* Replay = Character ? Character->GetInputReplay() : nullptr;
+        if (Replay && Replay->StartReplay(InputReplayName))
+        {
+            ActiveReplay = Replay;
+            ReplayFinishedHandle = Replay->OnReplayFinished.AddUObject(this, &UInteractionBenchmarkSubsystem::StopBenchmark);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("InteractionBenchmark: could not replay '%s', flying the orbit instead"), *InputReplayName);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("InteractionBenchmark: started with %d actors"), SpawnedActors.Num());
+}
+
+template <typename T>
+void UInteractionBenchmarkSubsystem::SpawnPopulation(const TSoftClassPtr<T>& ClassOverride, int32 Count, FRandomStream& Random)
+{
+    UClass* Class = ClassOverride.IsNull() ? T::StaticClass() : ClassOverride.LoadSynchronous();
+    if (!Class)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InteractionBenchmark: could not load %s"), *ClassOverride.ToString());
+        return;
+    }
+
+    FActorSpawnParameters Params;
+    Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    for (int32 i = 0; i < Count; ++i)
+    {
+        // Uniform over the disc; the random stream is consumed identically on every run
+        const float Angle = Random.FRandRange(0.0f, 2.0f * PI);
+        const float Distance = SpawnRadius * FMath::Sqrt(Random.FRand());
+        const FVector Location = PathCenter + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+        const FRotator Rotation(0.0f, Random.FRandRange(-180.0f, 180.0f), 0.0f);
+
+        if (AActor* Actor = GetWorld()->SpawnActor<AActor>(Class, Location, Rotation, Params))
+        {
+            SpawnedActors.Add(Actor);
+        }
+    }
+}
+
+void UInteractionBenchmarkSubsystem::StopBenchmark()
+{
+    if (!bRunning)
+    {
+        return;
+    }
+    bRunning = false;
+
+    if (UInputReplayComponent* Replay = ActiveReplay.Get())
+    {
+        Replay->OnReplayFinished.Remove(ReplayFinishedHandle);
+        Replay->StopReplay();
+    }
+    ActiveReplay.Reset();
+
+#if CSV_PROFILER
+    if (bOwnsCsvCapture)
+    {
+        FCsvProfiler::Get()->EndCapture();
+        bOwnsCsvCapture = false;
+    }
+#endif
+
+    WriteCsv();
+    const bool bWithinBudget = CheckBudget();
+
+    for (const TWeakObjectPtr<AActor>& Actor : SpawnedActors)
+    {
+        if (Actor.IsValid())
+        {
+            Actor->Destroy();
+        }
+    }
+    SpawnedActors.Reset();
+
+    FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+    FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+    if (SweepMaps.Num() > 0)
+    {
+        AdvanceMapSweep(bWithinBudget);
+    }
+    else if (bQuitOnFinish)
+    {
+        FPlatformMisc::RequestExitWithStatus(false, bWithinBudget ? 0 : 1);
+    }
+}
+
+void UInteractionBenchmarkSubsystem::AdvanceMapSweep(bool bWithinBudget)
+{
+    bSweepFailed |= !bWithinBudget;
+
+    const int32 NextMapIndex = SweepMapIndex + 1;
+    if (!SweepMaps.IsValidIndex(NextMapIndex))
+    {
+        UE_LOG(LogTemp, Log, TEXT("InteractionBenchmark: map sweep finished, %s"), bSweepFailed ? TEXT("over budget") : TEXT("within budget"));
+        FPlatformMisc::RequestExitWithStatus(false, bSweepFailed ? 1 : 0);
+        return;
+    }
+
+    const FString Options = FString::Printf(TEXT("BenchmarkMap=%d%s"), NextMapIndex, bSweepFailed ? TEXT("?BenchmarkFailed") : TEXT(""));
+    UGameplayStatics::OpenLevel(GetWorld(), FName(*SweepMaps[NextMapIndex]), true, Options);
+}
+
+void UInteractionBenchmarkSubsystem::Tick(float DeltaTime)
+{
+    if (bStartPending)
+    {
+        // The local player may not have a pawn on the first frames of a freshly loaded map
+        APlayerController* PC = GetWorld()->GetFirstPlayerController();
+        if (!PC || !PC->GetPawn())
+        {
+            return;
+        }
+        bStartPending = false;
+        StartBenchmark(bQuitOnFinish);
+        return;
+    }
+
+    SimulatedTime += DeltaTime;
+    ++FramesRun;
+
+    const bool bReplayingInput = ActiveReplay.IsValid();
+    if (!bReplayingInput)
+    {
+        DrivePath();
+    }
+
+    const int32 TraceCount = GetInteractionTraceCount();
+    const int32 TracesThisFrame = TraceCount - LastTraceCount;
+    LastTraceCount = TraceCount;
+
+    if (FramesRun > WarmupFrames)
+    {
+        FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+
+        // GGameThreadTime holds the previous frame's game thread cycles, so rows lag the path by one frame
+        Sample.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+        Sample.Traces = TracesThisFrame;
+        CSV_CUSTOM_STAT(Interaction, FocusTraces, TracesThisFrame, ECsvCustomStatOp::Set);
+
+        for (const TWeakObjectPtr<AActor>& Actor : SpawnedActors)
+        {
+            if (Actor.IsValid() && Actor->IsActorTickEnabled())
+            {
+                ++Sample.TickingActors;
+            }
+        }
+
+        if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+        {
+            Sample.FullTick = Significance->GetNumInBucket(ETickSignificance::Full);
+            Sample.ReducedTick = Significance->GetNumInBucket(ETickSignificance::Reduced);
+            Sample.DormantTick = Significance->GetNumInBucket(ETickSignificance::Dormant);
+        }
+    }
+
+    if (!bReplayingInput && SimulatedTime >= PathLapTime * PathLaps)
+    {
+        StopBenchmark();
+    }
+}
+
+void UInteractionBenchmarkSubsystem::DrivePath()
+{
+    APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    AMyFPSCharacter* Character = PC ? Cast<AMyFPSCharacter>(PC->GetPawn()) : nullptr;
+    if (!Character)
+    {
+        return;
+    }
+
+    // Orbit the spawn area while sweeping the view across it, so focus keeps changing
+    const float Phase = 2.0f * PI * SimulatedTime / FMath::Max(PathLapTime, 1.0f);
+    const FVector Offset(FMath::Cos(Phase) * PathRadius, FMath::Sin(Phase) * PathRadius, 0.0f);
+    Character->SetActorLocation(PathCenter + Offset, false, nullptr, ETeleportType::TeleportPhysics);
+
+    FRotator ViewRotation = (-Offset).Rotation();
+    ViewRotation.Yaw += 45.0f * FMath::Sin(Phase * 3.0f);
+    ViewRotation.Pitch = -10.0f * FMath::Sin(Phase * 2.0f);
+    PC->SetControlRotation(ViewRotation);
+}
+
+int32 UInteractionBenchmarkSubsystem::GetInteractionTraceCount() const
+{
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        if (AInteractManager* InteractManager = Registry->Find<AInteractManager>())
+        {
+            return InteractManager->GetTraceCount();
+        }
+    }
+    return 0;
+}
+
+void UInteractionBenchmarkSubsystem::WriteCsv() const
+{
+    FString Csv = TEXT("Frame,GameThreadMs,TickingActors,Traces,FullTick,ReducedTick,DormantTick\n");
+    TArray<float> FrameTimes;
+    FrameTimes.Reserve(Samples.Num());
+
+    for (int32 i = 0; i < Samples.Num(); ++i)
+    {
+        const FFrameSample& Sample = Samples[i];
+        Csv += FString::Printf(TEXT("%d,%.4f,%d,%d,%d,%d,%d\n"),
+            i, Sample.GameThreadMs, Sample.TickingActors, Sample.Traces, Sample.FullTick, Sample.ReducedTick, Sample.DormantTick);
+        FrameTimes.Add(Sample.GameThreadMs);
+    }
+
+    const FString MapName = GetShortMapName();
+    const FString Path = FPaths::ProfilingDir() / TEXT("InteractionBenchmark") / FString::Printf(TEXT("%s-%s.csv"), *MapName, *FDateTime::Now().ToString());
+    if (!FFileHelper::SaveStringToFile(Csv, *Path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("InteractionBenchmark: failed to write %s"), *Path);
+        return;
+    }
+
+    if (FrameTimes.Num() > 0)
+    {
+        FrameTimes.Sort();
+        float Total = 0.0f;
+        for (float Time : FrameTimes)
+        {
+            Total += Time;
+        }
+        UE_LOG(LogTemp, Log, TEXT("InteractionBenchmark: %d frames, game thread avg %.3f ms, p50 %.3f ms, p95 %.3f ms -> %s"),
+            FrameTimes.Num(), Total / FrameTimes.Num(),
+            FrameTimes[FrameTimes.Num() / 2], FrameTimes[FMath::Min(FrameTimes.Num() - 1, FrameTimes.Num() * 95 / 100)], *Path);
+    }
+}
+
+FString UInteractionBenchmarkSubsystem::GetShortMapName() const
+{
+    return GetWorld() ? UWorld::RemovePIEPrefix(GetWorld()->GetMapName()) : TEXT("Unknown");
+}
+
+int32 UInteractionBenchmarkSubsystem::GetConfiguredPopulation() const
+{
+    return PickableItemCount + FixableMachineCount + OxygenReplenishCount + WheepingAngleCount + DialogueTriggerCount;
+}
+
+TArray<FString> UInteractionBenchmarkSubsystem::GetBudgetedMaps() const
+{
+    TArray<FString> Maps;
+    if (!DefaultBudget.MapName.IsEmpty())
+    {
+        Maps.Add(DefaultBudget.MapName);
+    }
+    for (const FMapPerformanceBudget& Budget : MapBudgets)
+    {
+        Maps.AddUnique(Budget.MapName);
+    }
+    return Maps;
+}
+
+FInteractionBenchmarkResult UInteractionBenchmarkSubsystem::EvaluateBudget(TArray<float> FrameTimes, int32 MaxTickingActors, const FMapPerformanceBudget& Budget)
+{
+    FInteractionBenchmarkResult Result;
+    Result.Budget = Budget;
+    Result.Frames = FrameTimes.Num();
+    Result.MaxTickingActors = MaxTickingActors;
+    if (FrameTimes.Num() == 0)
+    {
+        return Result;
+    }
+    FrameTimes.Sort();
+
+    auto Percentile = [&FrameTimes](int32 Percent)
+    {
+        return FrameTimes[FMath::Min(FrameTimes.Num() - 1, FrameTimes.Num() * Percent / 100)];
+    };
+    Result.MedianMs = Percentile(50);
+    Result.P95Ms = Percentile(95);
+    Result.P99Ms = Percentile(99);
+
+    Result.bWithinBudget = Result.MedianMs <= Budget.MedianFrameMs && Result.P95Ms <= Budget.P95FrameMs
+        && Result.P99Ms <= Budget.P99FrameMs && MaxTickingActors <= Budget.MaxTickingActors;
+    return Result;
+}
+
+bool UInteractionBenchmarkSubsystem::CheckBudget()
+{
+    const FString MapName = GetShortMapName();
+    const FMapPerformanceBudget* Budget = MapBudgets.FindByPredicate([&MapName](const FMapPerformanceBudget& Entry) { return Entry.MapName == MapName; });
+    if (!Budget)
+    {
+        Budget = &DefaultBudget;
+    }
+
+    TArray<float> FrameTimes;
+    int32 MaxTicking = 0;
+    for (const FFrameSample& Sample : Samples)
+    {
+        FrameTimes.Add(Sample.GameThreadMs);
+        MaxTicking = FMath::Max(MaxTicking, Sample.TickingActors);
+    }
+
+    LastResult = EvaluateBudget(MoveTemp(FrameTimes), MaxTicking, *Budget);
+    LastResult.MapName = MapName;
+    LastResult.SpawnedActors = SpawnedActors.Num();
+    bHasResult = true;
+
+    if (LastResult.Frames == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InteractionBenchmark: no frames recorded for %s, budget not checked"), *MapName);
+        return true;
+    }
+
+    const float Median = LastResult.MedianMs;
+    const float P95 = LastResult.P95Ms;
+    const float P99 = LastResult.P99Ms;
+    const bool bWithinBudget = LastResult.bWithinBudget;
+
+    const FString ReportPath = FPaths::ProfilingDir() / TEXT("InteractionBenchmark") / TEXT("BudgetReport.csv");
+    FString Row;
+    if (!IFileManager::Get().FileExists(*ReportPath))
+    {
+        Row = TEXT("Map,Frames,MedianMs,P95Ms,P99Ms,MaxTickingActors,BudgetMedianMs,BudgetP95Ms,BudgetP99Ms,BudgetTickingActors,Result\n");
+    }
+    Row += FString::Printf(TEXT("%s,%d,%.3f,%.3f,%.3f,%d,%.3f,%.3f,%.3f,%d,%s\n"),
+        *MapName, LastResult.Frames, Median, P95, P99, MaxTicking,
+        Budget->MedianFrameMs, Budget->P95FrameMs, Budget->P99FrameMs, Budget->MaxTickingActors,
+        bWithinBudget ? TEXT("Pass") : TEXT("Fail"));
+    FFileHelper::SaveStringToFile(Row, *ReportPath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+
+    if (bWithinBudget)
+    {
+        UE_LOG(LogTemp, Log, TEXT("InteractionBenchmark: %s within budget"), *MapName);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("InteractionBenchmark: %s over budget (median %.3f/%.3f ms, p95 %.3f/%.3f ms, p99 %.3f/%.3f ms, ticking %d/%d)"),
+            *MapName, Median, Budget->MedianFrameMs, P95, Budget->P95FrameMs, P99, Budget->P99FrameMs, MaxTicking, Budget->MaxTickingActors);
+    }
+    return bWithinBudget;
+}
+
+TStatId UInteractionBenchmarkSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractionBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UInteractionBenchmarkSubsystem::GetTickableTickType() const
+{
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
@@ -1,9 +1,11 @@
 #include "ItemManager.h"
+#include "FirstPersonTest.h"
 #include "MyFPSCharacter.h"
 #include "Kismet/GameplayStatics.h"
 #include "Components/TextBlock.h"
 #include "Blueprint/UserWidget.h"
 #include "OxygenReplenishActor.h"
+#include "GameplayActorRegistry.h"
 
 AItemManager::AItemManager()
 {
@@ -28,6 +30,21 @@ void AItemManager::BeginPlay()
     {
         ItemNameWidget->SetVisibility(ESlateVisibility::Hidden);
     }
+
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Register<AItemManager>(this);
+    }
+}
+
+void AItemManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Unregister<AItemManager>(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AItemManager::Tick(float DeltaTime)
@@ -134,8 +151,25 @@ void AItemManager::DropItem()
     }
 }
 
+void AItemManager::ReleaseHeldItemImmediately()
+{
+    if (HeldItem)
+    {
+        HeldItem->Drop();
+    }
+
+    HeldItem = nullptr;
+    CurrentItemIndex = -1;
+    CurrentPickupState = EPickupState::None;
+    LerpTimer = 0.0f;
+}
+
 void AItemManager::ProcessRaycast()
 {
+    CSV_SCOPED_TIMING_STAT(Interaction, ItemRaycast);
+    SCOPE_CYCLE_COUNTER(STAT_ItemManagerRaycast);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AItemManager::ProcessRaycast);
+
     if (!PlayerRef)
     {
         UE_LOG(LogTemp, Warning, TEXT("ProcessRaycast: PlayerRef is NULL"));
@@ -162,6 +196,7 @@ void AItemManager::ProcessRaycast()
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(PlayerRef);
 
+    INC_DWORD_STAT(STAT_GameplayTraces);
     bool bHit = GetWorld()->LineTraceSingleByChannel(
         HitResult,
         CameraLocation,
@@ -271,6 +306,8 @@ void AItemManager::ProcessRaycast()
 
 void AItemManager::UpdateItemNameUI(const FText& DisplayName, bool bShow)
 {
+    CSV_SCOPED_TIMING_STAT(GameplayUI, ItemName);
+
     UE_LOG(LogTemp, Warning, TEXT("UpdateItemNameUI called - Show: %s, Text: %s"),
         bShow ? TEXT("true") : TEXT("false"),
         *DisplayName.ToString());
@@ -1,4 +1,5 @@
 #include "ItemNameWidget.h"
+#include "FirstPersonTest.h"
 
 void UItemNameWidget::NativeConstruct() 
 {
@@ -27,6 +28,8 @@ void UItemNameWidget::NativeConstruct()
 
 void UItemNameWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
+    CSV_SCOPED_TIMING_STAT(GameplayUI, ItemNameWidget);
+
     Super::NativeTick(MyGeometry, InDeltaTime);
     
     if (FrameCount < 5 && item_name_label)
@@ -0,0 +1,212 @@
+#include "LevelTransitionSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/PackageName.h"
+#include "Engine/AssetManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/ARFilter.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+void ULevelTransitionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ULevelTransitionSubsystem::OnPostLoadMap);
+}
+
+void ULevelTransitionSubsystem::Deinitialize()
+{
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+    PreloadedPackage = nullptr;
+    LoadingOverlay = nullptr;
+
+    if (LoadingOverlayHandle.IsValid())
+    {
+        LoadingOverlayHandle->CancelHandle();
+        LoadingOverlayHandle.Reset();
+    }
+
+    Super::Deinitialize();
+}
+
+ULevelTransitionSubsystem* ULevelTransitionSubsystem::Get(const UObject* WorldContextObject)
+{
+    UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+    return GameInstance ? GameInstance->GetSubsystem<ULevelTransitionSubsystem>() : nullptr;
+}
+
+FString ULevelTransitionSubsystem::ResolveLevelPackage(FName LevelName)
+{
+    const FString LevelString = LevelName.ToString();
+    if (FPackageName::IsValidLongPackageName(LevelString))
+    {
+        return LevelString;
+    }
+
+    // Short map names (as accepted by OpenLevel) are looked up in the asset registry, which is
+    // already in memory; searching the content directories on disk would hitch the game thread.
+    // The registry is only walked once, after which every lookup is a map find.
+    if (MapPackagesByName.Num() == 0)
+    {
+        IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+        FARFilter Filter;
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+        Filter.ClassPaths.Add(UWorld::StaticClass()->GetClassPathName());
+#else
+        Filter.ClassNames.Add(UWorld::StaticClass()->GetFName());
+#endif
+
+        TArray<FAssetData> Maps;
+        AssetRegistry.GetAssets(Filter, Maps);
+        for (const FAssetData& Map : Maps)
+        {
+            MapPackagesByName.Add(Map.AssetName, Map.PackageName);
+        }
+
+        // The editor may still be discovering assets; don't keep a partial list
+        if (AssetRegistry.IsLoadingAssets())
+        {
+            const FName* PackageName = MapPackagesByName.Find(LevelName);
+            const FString Result = PackageName ? PackageName->ToString() : FString();
+            MapPackagesByName.Reset();
+            return Result;
+        }
+    }
+
+    const FName* PackageName = MapPackagesByName.Find(LevelName);
+    return PackageName ? PackageName->ToString() : FString();
+}
+
+void ULevelTransitionSubsystem::PreloadLevel(FName LevelName)
+{
+    if (LevelName.IsNone() || (LevelName == PreloadLevelName && (bPreloadInFlight || PreloadedPackage)))
+    {
+        return;
+    }
+
+    const FString PackageName = ResolveLevelPackage(LevelName);
+    if (PackageName.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LevelTransition: Could not find map %s to preload"), *LevelName.ToString());
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("LevelTransition: Preloading %s"), *PackageName);
+
+    PreloadLevelName = LevelName;
+    PreloadedPackage = nullptr;
+    bPreloadInFlight = true;
+
+    if (!LoadingOverlayClass.IsNull() && !LoadingOverlayHandle.IsValid())
+    {
+        LoadingOverlayHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(LoadingOverlayClass.ToSoftObjectPath());
+    }
+
+    LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateUObject(this, &ULevelTransitionSubsystem::OnPreloadComplete));
+}
+
+void ULevelTransitionSubsystem::OnPreloadComplete(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+    bPreloadInFlight = false;
+
+    if (Result == EAsyncLoadingResult::Succeeded)
+    {
+        PreloadedPackage = LoadedPackage;
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LevelTransition: Preload of %s failed, travel will load synchronously"), *PackageName.ToString());
+    }
+
+    // A travel requested while loading was waiting for us
+    if (!PendingTravelLevel.IsNone())
+    {
+        const FName LevelName = PendingTravelLevel;
+        PendingTravelLevel = NAME_None;
+        SwitchToLevel(LevelName);
+    }
+}
+
+bool ULevelTransitionSubsystem::IsLevelPreloaded(FName LevelName) const
+{
+    return LevelName == PreloadLevelName && PreloadedPackage != nullptr;
+}
+
+void ULevelTransitionSubsystem::TravelToLevel(FName LevelName)
+{
+    if (LevelName.IsNone())
+    {
+        UE_LOG(LogTemp, Error, TEXT("LevelTransition: No level name given"));
+        return;
+    }
+
+    ShowLoadingOverlay();
+
+    if (bPreloadInFlight && LevelName == PreloadLevelName)
+    {
+        PendingTravelLevel = LevelName;
+        return;
+    }
+
+    SwitchToLevel(LevelName);
+}
+
+void ULevelTransitionSubsystem::SwitchToLevel(FName LevelName)
+{
+    UWorld* World = GetGameInstance() ? GetGameInstance()->GetWorld() : nullptr;
+    if (!World)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("LevelTransition: Travelling to %s (preloaded: %s)"),
+           *LevelName.ToString(), IsLevelPreloaded(LevelName) ? TEXT("yes") : TEXT("no"));
+
+    if (bUseSeamlessTravel && World->GetNetMode() != NM_Client)
+    {
+        World->ServerTravel(LevelName.ToString());
+    }
+    else
+    {
+        UGameplayStatics::OpenLevel(World, LevelName);
+    }
+}
+
+void ULevelTransitionSubsystem::ShowLoadingOverlay()
+{
+    if (LoadingOverlay || LoadingOverlayClass.IsNull())
+    {
+        return;
+    }
+
+    APlayerController* PC = GetGameInstance() ? GetGameInstance()->GetFirstLocalPlayerController() : nullptr;
+    // Resident if the map was preloaded; a travel with no preload before it is the only path that still blocks
+    UClass* OverlayClass = LoadingOverlayClass.Get() ? LoadingOverlayClass.Get() : LoadingOverlayClass.LoadSynchronous();
+    if (PC && OverlayClass)
+    {
+        LoadingOverlay = CreateWidget<UUserWidget>(PC, OverlayClass);
+        if (LoadingOverlay)
+        {
+            LoadingOverlay->AddToViewport(LoadingOverlayZOrder);
+        }
+    }
+}
+
+void ULevelTransitionSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+    // The new map now owns its objects; drop the preload reference and the old overlay
+    PreloadedPackage = nullptr;
+    PreloadLevelName = NAME_None;
+
+    if (LoadingOverlay)
+    {
+        LoadingOverlay->RemoveFromParent();
+        LoadingOverlay = nullptr;
+    }
+}
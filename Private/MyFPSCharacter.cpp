@@ -1,4 +1,5 @@
 #include "MyFPSCharacter.h"
+#include "FirstPersonTest.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "DrawDebugHelpers.h"
@@ -10,6 +11,10 @@
 #include "Components/TextBlock.h"
 #include "PickableItem.h"
 #include "OxygenReplenishActor.h"
+#include "GameplayActorRegistry.h"
+#include "CameraSwayModifier.h"
+#include "CameraSwayProfile.h"
+#include "Camera/PlayerCameraManager.h"
 
 AMyFPSCharacter::AMyFPSCharacter()
 {
@@ -28,10 +33,46 @@ AMyFPSCharacter::AMyFPSCharacter()
     GetCharacterMovement()->JumpZVelocity = 400.f;
     GetCharacterMovement()->AirControl = 0.2f;
 
-    BreathingPhase = 0.0f;
-    LastZVelocity = 0.0f;
-    bWasInAir = false;
     PhysicsGrabComponent = CreateDefaultSubobject<UPhysicsGrabComponent>(TEXT("PhysicsGrabComponent"));
+    InputReplay = CreateDefaultSubobject<UInputReplayComponent>(TEXT("InputReplay"));
+}
+
+void AMyFPSCharacter::PostLoad()
+{
+    Super::PostLoad();
+
+    const AMyFPSCharacter* Defaults = GetDefault<AMyFPSCharacter>();
+    const bool bHasCustomSway = PositionalSwayAmount_DEPRECATED != Defaults->PositionalSwayAmount_DEPRECATED
+        || RotationalSwayAmount_DEPRECATED != Defaults->RotationalSwayAmount_DEPRECATED
+        || SwaySpeed_DEPRECATED != Defaults->SwaySpeed_DEPRECATED
+        || ReturnSpeed_DEPRECATED != Defaults->ReturnSpeed_DEPRECATED
+        || LandingBobAmount_DEPRECATED != Defaults->LandingBobAmount_DEPRECATED
+        || BreathingAmount_DEPRECATED != Defaults->BreathingAmount_DEPRECATED
+        || BreathingSpeed_DEPRECATED != Defaults->BreathingSpeed_DEPRECATED;
+    if (!bHasCustomSway || WalkSwayProfile)
+    {
+        return;
+    }
+
+    // Saved with this object, so resaving the Blueprint or level makes the migration permanent
+    UCameraSwayProfile* Migrated = NewObject<UCameraSwayProfile>(this, TEXT("MigratedWalkSwayProfile"));
+    Migrated->BobAmount = PositionalSwayAmount_DEPRECATED;
+    Migrated->RotationalSwayAmount = RotationalSwayAmount_DEPRECATED;
+    Migrated->SwaySpeed = SwaySpeed_DEPRECATED;
+    Migrated->ReturnSpeed = ReturnSpeed_DEPRECATED;
+    Migrated->LandingBobAmount = LandingBobAmount_DEPRECATED;
+    Migrated->BreathingAmount = BreathingAmount_DEPRECATED;
+    // The old breathing phase advanced in radians per second
+    Migrated->BreathingRate = BreathingSpeed_DEPRECATED / (2.0f * PI);
+    WalkSwayProfile = Migrated;
+
+    PositionalSwayAmount_DEPRECATED = Defaults->PositionalSwayAmount_DEPRECATED;
+    RotationalSwayAmount_DEPRECATED = Defaults->RotationalSwayAmount_DEPRECATED;
+    SwaySpeed_DEPRECATED = Defaults->SwaySpeed_DEPRECATED;
+    ReturnSpeed_DEPRECATED = Defaults->ReturnSpeed_DEPRECATED;
+    LandingBobAmount_DEPRECATED = Defaults->LandingBobAmount_DEPRECATED;
+    BreathingAmount_DEPRECATED = Defaults->BreathingAmount_DEPRECATED;
+    BreathingSpeed_DEPRECATED = Defaults->BreathingSpeed_DEPRECATED;
 }
 
 void AMyFPSCharacter::BeginPlay()
@@ -42,14 +83,20 @@ void AMyFPSCharacter::BeginPlay()
     GetCharacterMovement()->PushForceFactor = PushForceFactor;
     GetCharacterMovement()->PushForcePointZOffsetFactor = PushForcePointZOffset;
 
-    InitialCameraRotation = FirstPersonCamera->GetRelativeRotation();
-    InitialCameraLocation = FirstPersonCamera->GetRelativeLocation();
-    CurrentRotationalSway = FRotator::ZeroRotator;
-    CurrentPositionalSway = FVector::ZeroVector;
     DefaultMaxWalkSpeed = GetCharacterMovement()->MaxWalkSpeed;
 
+    // Sway is applied to the view by the camera manager rather than by moving FirstPersonCamera
+    if (APlayerController* PC = Cast<APlayerController>(GetController()))
+    {
+        if (PC->PlayerCameraManager && !PC->PlayerCameraManager->FindCameraModifierByClass(UCameraSwayModifier::StaticClass()))
+        {
+            PC->PlayerCameraManager->AddNewCameraModifier(UCameraSwayModifier::StaticClass());
+        }
+    }
+
     UE_LOG(LogTemp, Warning, TEXT("MyFPSCharacter::BeginPlay - Creating item name widget"));
 
+    UTextBlock* ItemNameLabel = nullptr;
     if (ItemNameWidgetClass)
     {
         UE_LOG(LogTemp, Warning, TEXT("ItemNameWidgetClass is valid"));
@@ -65,35 +112,10 @@ void AMyFPSCharacter::BeginPlay()
                 UE_LOG(LogTemp, Warning, TEXT("ItemNameWidget created successfully"));
                 ItemNameWidget->AddToViewport();
 
-                UTextBlock* ItemNameLabel = ItemNameWidget->GetItemNameLabel();
+                ItemNameLabel = ItemNameWidget->GetItemNameLabel();
                 if (ItemNameLabel)
                 {
                     UE_LOG(LogTemp, Warning, TEXT("ItemNameLabel found in widget"));
-
-                    TArray<AActor*> FoundActors;
-                    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AItemManager::StaticClass(), FoundActors);
-                    if (FoundActors.Num() > 0)
-                    {
-                        UE_LOG(LogTemp, Warning, TEXT("Found %d ItemManager actors"), FoundActors.Num());
-
-                        ItemManagerRef = Cast<AItemManager>(FoundActors[0]);
-                        if (ItemManagerRef)
-                        {
-                            UE_LOG(LogTemp, Warning, TEXT("ItemManagerRef valid, registering player and UI"));
-
-                            ItemManagerRef->RegisterPlayerRaycast(this);
-                            ItemManagerRef->RegisterPickupOrigin(ItemHoldPoint);
-                            ItemManagerRef->RegisterItemNameWidget(ItemNameWidget, ItemNameLabel);
-                        }
-                        else
-                        {
-                            UE_LOG(LogTemp, Error, TEXT("Failed to cast to ItemManager!"));
-                        }
-                    }
-                    else
-                    {
-                        UE_LOG(LogTemp, Error, TEXT("No ItemManager actors found in level!"));
-                    }
                 }
                 else
                 {
@@ -113,39 +135,42 @@ void AMyFPSCharacter::BeginPlay()
     else
     {
         UE_LOG(LogTemp, Warning, TEXT("ItemNameWidgetClass not set! Make sure to assign it in the editor."));
+    }
 
-        TArray<AActor*> FoundActors;
-        UGameplayStatics::GetAllActorsOfClass(GetWorld(), AItemManager::StaticClass(), FoundActors);
-        if (FoundActors.Num() > 0)
-        {
-            ItemManagerRef = Cast<AItemManager>(FoundActors[0]);
-            if (ItemManagerRef)
-            {
-                ItemManagerRef->RegisterPlayerRaycast(this);
-                ItemManagerRef->RegisterPickupOrigin(ItemHoldPoint);
-            }
-        }
+    // Managers register themselves with the world's actor registry; if they begin play
+    // after the character these callbacks fire once they do
+    UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this);
+    if (!Registry)
+    {
+        UE_LOG(LogTemp, Error, TEXT("No gameplay actor registry for this world!"));
+        return;
     }
 
-    TArray<AActor*> FoundActors;
-    UGameplayStatics::GetAllActorsOfClass(GetWorld(), AInteractManager::StaticClass(), FoundActors);
-    if (FoundActors.Num() > 0)
+    Registry->WhenRegistered<AItemManager>(this, [this, ItemNameLabel](AItemManager* ItemManager)
     {
-        InteractManagerRef = Cast<AInteractManager>(FoundActors[0]);
-        if (InteractManagerRef)
+        UE_LOG(LogTemp, Warning, TEXT("ItemManagerRef valid, registering player and UI"));
+
+        ItemManagerRef = ItemManager;
+        ItemManagerRef->RegisterPlayerRaycast(this);
+        ItemManagerRef->RegisterPickupOrigin(ItemHoldPoint);
+        if (ItemNameWidget && ItemNameLabel)
         {
-            InteractManagerRef->RegisterPlayerCharacter(this);
-            InteractManagerRef->RegisterPlayerController(Cast<APlayerController>(GetController()));
+            ItemManagerRef->RegisterItemNameWidget(ItemNameWidget, ItemNameLabel);
         }
-    }
+    });
+
+    Registry->WhenRegistered<AInteractManager>(this, [this](AInteractManager* InteractManager)
+    {
+        InteractManagerRef = InteractManager;
+        InteractManagerRef->RegisterPlayerCharacter(this);
+        InteractManagerRef->RegisterPlayerController(Cast<APlayerController>(GetController()));
+    });
 }
 
 void AMyFPSCharacter::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    HandleCameraSway(DeltaTime);
-
     PerformCameraRaycast();
 }
 
@@ -153,24 +178,164 @@ void AMyFPSCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComp
 {
     Super::SetupPlayerInputComponent(PlayerInputComponent);
 
-    PlayerInputComponent->BindAxis("MoveForward", this, &AMyFPSCharacter::MoveForward);
-    PlayerInputComponent->BindAxis("MoveRight", this, &AMyFPSCharacter::MoveRight);
+    PlayerInputComponent->BindAxis("MoveForward", this, &AMyFPSCharacter::InputMoveForward);
+    PlayerInputComponent->BindAxis("MoveRight", this, &AMyFPSCharacter::InputMoveRight);
+
+    PlayerInputComponent->BindAxis("Turn", this, &AMyFPSCharacter::InputTurn);
+    PlayerInputComponent->BindAxis("LookUp", this, &AMyFPSCharacter::InputLookUp);
+
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("Jump", IE_Pressed, this, &AMyFPSCharacter::InputActionPressed, EReplayInputAction::Jump);
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("Jump", IE_Released, this, &AMyFPSCharacter::InputActionReleased, EReplayInputAction::Jump);
+
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("Sprint", IE_Pressed, this, &AMyFPSCharacter::InputActionPressed, EReplayInputAction::Sprint);
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("Sprint", IE_Released, this, &AMyFPSCharacter::InputActionReleased, EReplayInputAction::Sprint);
 
-    PlayerInputComponent->BindAxis("Turn", this, &APawn::AddControllerYawInput);
-    PlayerInputComponent->BindAxis("LookUp", this, &APawn::AddControllerPitchInput);
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("Interact", IE_Pressed, this, &AMyFPSCharacter::InputActionPressed, EReplayInputAction::Interact);
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("Interact", IE_Released, this, &AMyFPSCharacter::InputActionReleased, EReplayInputAction::Interact);
 
-    PlayerInputComponent->BindAction("Jump", IE_Pressed, this, &ACharacter::Jump);
-    PlayerInputComponent->BindAction("Jump", IE_Released, this, &ACharacter::StopJumping);
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("PhysicsGrab", IE_Pressed, this, &AMyFPSCharacter::InputActionPressed, EReplayInputAction::PhysicsGrab);
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("PhysicsGrab", IE_Released, this, &AMyFPSCharacter::InputActionReleased, EReplayInputAction::PhysicsGrab);
+    PlayerInputComponent->BindAction<FReplayInputActionDelegate>("ThrowObject", IE_Pressed, this, &AMyFPSCharacter::InputActionPressed, EReplayInputAction::Throw);
+}
+
+void AMyFPSCharacter::InputMoveForward(float Value)
+{
+    LiveInput.MoveForward = Value;
+    if (!IsReplayingInput())
+    {
+        MoveForward(Value);
+    }
+}
+
+void AMyFPSCharacter::InputMoveRight(float Value)
+{
+    LiveInput.MoveRight = Value;
+    if (!IsReplayingInput())
+    {
+        MoveRight(Value);
+    }
+}
+
+void AMyFPSCharacter::InputTurn(float Value)
+{
+    LiveInput.Turn = Value;
+    if (!IsReplayingInput())
+    {
+        AddControllerYawInput(Value);
+    }
+}
+
+void AMyFPSCharacter::InputLookUp(float Value)
+{
+    LiveInput.LookUp = Value;
+    if (!IsReplayingInput())
+    {
+        AddControllerPitchInput(Value);
+    }
+}
+
+void AMyFPSCharacter::InputActionPressed(EReplayInputAction Action)
+{
+    LiveInput.Pressed |= Action;
+    if (!IsReplayingInput())
+    {
+        DispatchAction(Action, true);
+    }
+}
+
+void AMyFPSCharacter::InputActionReleased(EReplayInputAction Action)
+{
+    LiveInput.Released |= Action;
+    if (!IsReplayingInput())
+    {
+        DispatchAction(Action, false);
+    }
+}
+
+void AMyFPSCharacter::DispatchAction(EReplayInputAction Action, bool bPressed)
+{
+    switch (Action)
+    {
+    case EReplayInputAction::Jump:
+        if (bPressed)
+        {
+            Jump();
+        }
+        else
+        {
+            StopJumping();
+        }
+        break;
+    case EReplayInputAction::Sprint:
+        if (bPressed)
+        {
+            StartSprint();
+        }
+        else
+        {
+            StopSprint();
+        }
+        break;
+    case EReplayInputAction::Interact:
+        if (bPressed)
+        {
+            StartInteract();
+        }
+        else
+        {
+            StopInteract();
+        }
+        break;
+    case EReplayInputAction::PhysicsGrab:
+        if (bPressed)
+        {
+            StartPhysicsGrab();
+        }
+        else
+        {
+            StopPhysicsGrab();
+        }
+        break;
+    case EReplayInputAction::Throw:
+        if (bPressed)
+        {
+            ThrowObject();
+        }
+        break;
+    default:
+        break;
+    }
+}
 
-    PlayerInputComponent->BindAction("Sprint", IE_Pressed, this, &AMyFPSCharacter::StartSprint);
-    PlayerInputComponent->BindAction("Sprint", IE_Released, this, &AMyFPSCharacter::StopSprint);
+FRecordedInputFrame AMyFPSCharacter::ConsumeLiveInput()
+{
+    FRecordedInputFrame Frame = LiveInput;
+    LiveInput.Pressed = EReplayInputAction::None;
+    LiveInput.Released = EReplayInputAction::None;
+    return Frame;
+}
 
-    PlayerInputComponent->BindAction("Interact", IE_Pressed, this, &AMyFPSCharacter::StartInteract);
-    PlayerInputComponent->BindAction("Interact", IE_Released, this, &AMyFPSCharacter::StopInteract);
+void AMyFPSCharacter::ApplyInputFrame(const FRecordedInputFrame& Frame)
+{
+    MoveForward(Frame.MoveForward);
+    MoveRight(Frame.MoveRight);
+    AddControllerYawInput(Frame.Turn);
+    AddControllerPitchInput(Frame.LookUp);
 
-    PlayerInputComponent->BindAction("PhysicsGrab", IE_Pressed, this, &AMyFPSCharacter::StartPhysicsGrab);
-    PlayerInputComponent->BindAction("PhysicsGrab", IE_Released, this, &AMyFPSCharacter::StopPhysicsGrab);
-    PlayerInputComponent->BindAction("ThrowObject", IE_Pressed, this, &AMyFPSCharacter::ThrowObject);
+    for (uint8 Bit = 1; Bit <= static_cast<uint8>(EReplayInputAction::Throw); Bit <<= 1)
+    {
+        if (EnumHasAnyFlags(Frame.Pressed, static_cast<EReplayInputAction>(Bit)))
+        {
+            DispatchAction(static_cast<EReplayInputAction>(Bit), true);
+        }
+    }
+    for (uint8 Bit = 1; Bit <= static_cast<uint8>(EReplayInputAction::Throw); Bit <<= 1)
+    {
+        if (EnumHasAnyFlags(Frame.Released, static_cast<EReplayInputAction>(Bit)))
+        {
+            DispatchAction(static_cast<EReplayInputAction>(Bit), false);
+        }
+    }
 }
 
 void AMyFPSCharacter::StartPhysicsGrab()
@@ -242,73 +407,10 @@ void AMyFPSCharacter::StopSprint()
     GetCharacterMovement()->MaxWalkSpeed = DefaultMaxWalkSpeed;
 }
 
-void AMyFPSCharacter::HandleCameraSway(float DeltaTime)
-{
-    float ForwardSpeed = FVector::DotProduct(GetVelocity(), GetActorForwardVector());
-    float RightSpeed = FVector::DotProduct(GetVelocity(), GetActorRightVector());
-    float VerticalSpeed = GetVelocity().Z;
-
-    bool bIsInAir = GetCharacterMovement()->IsFalling();
-    bool bJustLanded = bWasInAir && !bIsInAir;
-    bWasInAir = bIsInAir;
-
-    if (bJustLanded)
-    {
-        float ImpactStrength = FMath::Abs(LastZVelocity) / 500.0f;
-        CurrentPositionalSway.Z -= LandingBobAmount * ImpactStrength;
-    }
-
-    LastZVelocity = VerticalSpeed;
-
-    FRotator TargetRotationalSway;
-    TargetRotationalSway.Pitch = -RightSpeed * 0.01f * RotationalSwayAmount;
-    TargetRotationalSway.Yaw = ForwardSpeed * 0.005f * RotationalSwayAmount;
-    TargetRotationalSway.Roll = RightSpeed * 0.015f * RotationalSwayAmount;
-
-    FVector TargetPositionalSway = FVector::ZeroVector;
-
-    if (!bIsInAir)
-    {
-        float SpeedFactor = GetVelocity().Size() / 500.0f;
-
-        float BobFrequency = SpeedFactor * 5.0f;
-
-        float TimeSeconds = GetWorld()->GetTimeSeconds();
-        TargetPositionalSway.Y = FMath::Sin(TimeSeconds * BobFrequency) * PositionalSwayAmount * SpeedFactor;
-        TargetPositionalSway.Z = FMath::Sin(TimeSeconds * BobFrequency * 2.0f) * PositionalSwayAmount * 0.5f * SpeedFactor;
-    }
-
-    BreathingPhase += DeltaTime * BreathingSpeed;
-    if (BreathingPhase > 2.0f * PI)
-    {
-        BreathingPhase -= 2.0f * PI;
-    }
-
-    TargetRotationalSway.Pitch += FMath::Sin(BreathingPhase) * BreathingAmount;
-    TargetPositionalSway.Z += FMath::Sin(BreathingPhase * 0.5f) * BreathingAmount * 1.5f;
-
-    if (bIsSprinting && !bIsInAir && GetVelocity().SizeSquared() > 100.0f)
-    {
-        TargetRotationalSway.Pitch -= 2.0f;
-
-        TargetPositionalSway *= 1.5f;
-    }
-
-    CurrentRotationalSway = FMath::RInterpTo(CurrentRotationalSway, TargetRotationalSway, DeltaTime, SwaySpeed);
-    CurrentPositionalSway = FMath::VInterpTo(CurrentPositionalSway, TargetPositionalSway, DeltaTime, SwaySpeed);
-
-    if (GetVelocity().IsNearlyZero() && !bIsInAir)
-    {
-        CurrentRotationalSway = FMath::RInterpTo(CurrentRotationalSway, FRotator::ZeroRotator, DeltaTime, ReturnSpeed);
-        CurrentPositionalSway = FMath::VInterpTo(CurrentPositionalSway, FVector::ZeroVector, DeltaTime, ReturnSpeed);
-    }
-
-    FirstPersonCamera->SetRelativeRotation(InitialCameraRotation + CurrentRotationalSway);
-    FirstPersonCamera->SetRelativeLocation(InitialCameraLocation + CurrentPositionalSway);
-}
-
 void AMyFPSCharacter::PerformCameraRaycast()
 {
+    CSV_SCOPED_TIMING_STAT(Interaction, CameraRaycast);
+
     APlayerController* PC = Cast<APlayerController>(GetController());
     if (!PC)
         return;
@@ -327,6 +429,7 @@ void AMyFPSCharacter::PerformCameraRaycast()
     QueryParams.bTraceComplex = true;
 
     FHitResult HitResult;
+    INC_DWORD_STAT(STAT_GameplayTraces);
     bool bHit = GetWorld()->LineTraceSingleByChannel(
         HitResult,
         CameraLocation,
@@ -1,4 +1,5 @@
 #include "MyFPSHUD.h"
+#include "FirstPersonTest.h"
 #include "Engine/Canvas.h"
 #include "Engine/Texture2D.h"
 #include "TextureResource.h"
@@ -16,6 +17,8 @@ AMyFPSHUD::AMyFPSHUD()
 
 void AMyFPSHUD::DrawHUD()
 {
+    CSV_SCOPED_TIMING_STAT(GameplayUI, DrawHUD);
+
     Super::DrawHUD();
     
     if (!bShowCrosshair)
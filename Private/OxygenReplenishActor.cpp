@@ -5,6 +5,7 @@
 #include "Blueprint/UserWidget.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
+#include "GameplayActorRegistry.h"
 
 AOxygenReplenishActor::AOxygenReplenishActor()
 {
@@ -28,11 +29,13 @@ void AOxygenReplenishActor::BeginPlay()
 	InteractionSphere->OnComponentBeginOverlap.AddDynamic(this, &AOxygenReplenishActor::OnInteractionSphereBeginOverlap);
 	InteractionSphere->OnComponentEndOverlap.AddDynamic(this, &AOxygenReplenishActor::OnInteractionSphereEndOverlap);
 	
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), APlayerOxygenSystem::StaticClass(), FoundActors);
-	if (FoundActors.Num() > 0)
+	if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
 	{
-		PlayerOxygenSystem = Cast<APlayerOxygenSystem>(FoundActors[0]);
+		Registry->WhenRegistered<APlayerOxygenSystem>(this, [this](APlayerOxygenSystem* OxygenSystem)
+		{
+			PlayerOxygenSystem = OxygenSystem;
+		});
+		Registry->Register<AOxygenReplenishActor>(this);
 	}
 	
     // Store the original material
@@ -63,6 +66,16 @@ void AOxygenReplenishActor::BeginPlay()
     }
 }
 
+void AOxygenReplenishActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+	{
+		Registry->Unregister<AOxygenReplenishActor>(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 void AOxygenReplenishActor::OnInteractionSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
 	if (OtherActor && OtherActor->IsA(ACharacter::StaticClass()))
@@ -82,18 +95,32 @@ void AOxygenReplenishActor::OnInteractionSphereEndOverlap(UPrimitiveComponent* O
 
 void AOxygenReplenishActor::PerformInteraction(AActor* Interactor)
 {
-	if (bCanInteract && PlayerOxygenSystem)
+	if (bCanInteract && !bConsumed && PlayerOxygenSystem)
 	{
 		PlayerOxygenSystem->AddOxygen(OxygenAmount);
 		
 		if (bDestroyAfterUse)
 		{
-            ShowInteractPrompt(false);
-			Destroy();
+			SetConsumed(true);
 		}
 	}
 }
 
+void AOxygenReplenishActor::SetConsumed(bool bInConsumed)
+{
+	bConsumed = bInConsumed;
+	
+	// Collision off also ends the sphere overlap, so bCanInteract is cleared through OnInteractionSphereEndOverlap
+	SetActorHiddenInGame(bConsumed);
+	SetActorEnableCollision(!bConsumed);
+	
+	if (bConsumed)
+	{
+		bCanInteract = false;
+		ShowInteractPrompt(false);
+	}
+}
+
 void AOxygenReplenishActor::ShowInteractPrompt(bool bShow)
 {
     if (InteractWidget)
@@ -128,7 +155,7 @@ void AOxygenReplenishActor::Interact_Implementation(AActor* Interactor)
 
 bool AOxygenReplenishActor::CanInteract_Implementation() const
 {
-    return bCanInteract;
+    return bCanInteract && !bConsumed;
 }
 
 FText AOxygenReplenishActor::GetInteractionText_Implementation() const
@@ -5,7 +5,9 @@
 
 AP_FixableMachine::AP_FixableMachine()
 {
+    // Only ticks while a repair is in progress or abandoned progress is decaying
     PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
 
     MachineMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MachineMesh"));
     RootComponent = MachineMesh;
@@ -42,21 +44,40 @@ void AP_FixableMachine::Tick(float DeltaTime)
     Super::Tick(DeltaTime);
 
     if (bIsFixed)
+    {
+        SetActorTickEnabled(false);
         return;
+    }
 
     if (bIsBeingFixed)
     {
         UpdateFixingProgress(DeltaTime);
+        return;
     }
-    else if (FixingProgress > 0.0f)
+
+    const float Progress = GetFixingProgress();
+    if (PuzzleManagerRef)
     {
-        FixingProgress = FMath::Max(0.0f, FixingProgress - (DeltaTime / TimeToFix) * ProgressDecayRate);
-        
-        if (PuzzleManagerRef)
-        {
-            PuzzleManagerRef->UpdateFixingProgress(FixingProgress);
-        }
+        PuzzleManagerRef->UpdateFixingProgress(this, Progress);
     }
+
+    if (Progress <= 0.0f)
+    {
+        FixingProgress = 0.0f;
+        DecayStartTime = -1.0f;
+        SetActorTickEnabled(false);
+    }
+}
+
+float AP_FixableMachine::GetFixingProgress() const
+{
+    if (bIsFixed || bIsBeingFixed || DecayStartTime < 0.0f || !GetWorld())
+    {
+        return FixingProgress;
+    }
+
+    const float Elapsed = GetWorld()->GetTimeSeconds() - DecayStartTime;
+    return FMath::Max(0.0f, FixingProgress - (Elapsed / TimeToFix) * ProgressDecayRate);
 }
 
 void AP_FixableMachine::OnHighlight_Implementation()
@@ -116,11 +137,28 @@ FText AP_FixableMachine::GetInteractionText_Implementation() const
     return InteractionText;
 }
 
+void AP_FixableMachine::BeginHold(AActor* Interactor)
+{
+    if (!bIsFixed && !bIsBeingFixed)
+    {
+        StartFixing();
+    }
+}
+
+void AP_FixableMachine::EndHold(AActor* Interactor)
+{
+    StopFixing();
+}
+
 void AP_FixableMachine::StartFixing()
 {
     if (!bIsFixed)
     {
+        // Pick up from wherever the abandoned progress has decayed to
+        FixingProgress = GetFixingProgress();
+        DecayStartTime = -1.0f;
         bIsBeingFixed = true;
+        SetActorTickEnabled(true);
         if (PuzzleManagerRef)
         {
             PuzzleManagerRef->OnMachineStartFixing(this);
@@ -133,6 +171,8 @@ void AP_FixableMachine::StopFixing()
     if (bIsBeingFixed)
     {
         bIsBeingFixed = false;
+        DecayStartTime = GetWorld()->GetTimeSeconds();
+        SetActorTickEnabled(FixingProgress > 0.0f);
         if (PuzzleManagerRef)
         {
             PuzzleManagerRef->OnMachineStopFixing(this);
@@ -148,7 +188,7 @@ void AP_FixableMachine::UpdateFixingProgress(float DeltaTime)
         
         if (PuzzleManagerRef)
         {
-            PuzzleManagerRef->UpdateFixingProgress(FixingProgress);
+            PuzzleManagerRef->UpdateFixingProgress(this, FixingProgress);
         }
 
         if (FixingProgress >= 1.0f)
@@ -163,6 +203,8 @@ void AP_FixableMachine::CompleteFix()
     bIsFixed = true;
     bIsBeingFixed = false;
     FixingProgress = 1.0f;
+    DecayStartTime = -1.0f;
+    SetActorTickEnabled(false);
 
     if (FixedMaterial)
     {
@@ -177,6 +219,21 @@ void AP_FixableMachine::CompleteFix()
     }
 }
 
+void AP_FixableMachine::RestoreState(float InFixingProgress, bool bInIsFixed)
+{
+    bIsFixed = bInIsFixed;
+    bIsBeingFixed = false;
+    FixingProgress = bInIsFixed ? 1.0f : FMath::Clamp(InFixingProgress, 0.0f, 1.0f);
+    DecayStartTime = -1.0f;
+    SetActorTickEnabled(false);
+
+    UMaterialInterface* Material = bIsFixed ? FixedMaterial : BrokenMaterial;
+    if (Material)
+    {
+        MachineMesh->SetMaterial(0, Material);
+    }
+}
+
 void AP_FixableMachine::SetPuzzleManager(APuzzleManager* Manager)
 {
     PuzzleManagerRef = Manager;
@@ -1,9 +1,11 @@
 #include "PhysicsGrabComponent.h"
+#include "FirstPersonTest.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/Character.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/SplineMeshComponent.h"
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
@@ -20,15 +22,49 @@ void UPhysicsGrabComponent::BeginPlay()
 {
     Super::BeginPlay();
     LastPlayerLocation = GetOwner()->GetActorLocation();
+
+    if (bShowThrowPreview && ThrowPreviewMesh)
+    {
+        PreviewPoints.SetNumZeroed(ThrowPreviewPoints);
+        PreviewSegmentClear.Init(1.0f, ThrowPreviewPoints - 1);
+
+        // Kept in world space so the arc points can be handed to it as they are
+        ThrowPreviewComponent = NewObject<USplineMeshComponent>(GetOwner(), TEXT("ThrowPreview"));
+        ThrowPreviewComponent->SetMobility(EComponentMobility::Movable);
+        ThrowPreviewComponent->SetUsingAbsoluteLocation(true);
+        ThrowPreviewComponent->SetUsingAbsoluteRotation(true);
+        ThrowPreviewComponent->SetUsingAbsoluteScale(true);
+        ThrowPreviewComponent->SetStaticMesh(ThrowPreviewMesh);
+        if (ThrowPreviewMaterial)
+        {
+            ThrowPreviewComponent->SetMaterial(0, ThrowPreviewMaterial);
+        }
+        ThrowPreviewComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        ThrowPreviewComponent->SetCastShadow(false);
+        ThrowPreviewComponent->SetVisibility(false);
+        ThrowPreviewComponent->SetupAttachment(GetOwner()->GetRootComponent());
+        ThrowPreviewComponent->RegisterComponent();
+    }
 }
 
 void UPhysicsGrabComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+    CSV_SCOPED_TIMING_STAT(PhysicsGrab, Tick);
+
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
     if (bIsGrabbing && GrabbedActor)
     {
         UpdateGrabbedObject(DeltaTime);
+
+        if (bShowThrowPreview)
+        {
+            UpdateThrowPreview();
+        }
+        else
+        {
+            HideThrowPreview();
+        }
     }
     else
     {
@@ -40,6 +76,9 @@ void UPhysicsGrabComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 
 void UPhysicsGrabComponent::PerformGrabTrace()
 {
+    SCOPE_CYCLE_COUNTER(STAT_PhysicsGrabTrace);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPhysicsGrabComponent::PerformGrabTrace);
+
     UCameraComponent* Camera = GetPlayerCamera();
     if (!Camera)
         return;
@@ -53,6 +92,7 @@ void UPhysicsGrabComponent::PerformGrabTrace()
     QueryParams.AddIgnoredActor(GetOwner());
     QueryParams.bTraceComplex = false;
 
+    INC_DWORD_STAT(STAT_GameplayTraces);
     bool bHit = GetWorld()->LineTraceSingleByChannel(
         HitResult,
         CameraLocation,
@@ -172,6 +212,7 @@ void UPhysicsGrabComponent::StartGrab()
     FCollisionQueryParams QueryParams;
     QueryParams.AddIgnoredActor(GetOwner());
 
+    INC_DWORD_STAT(STAT_GameplayTraces);
     bool bHit = GetWorld()->LineTraceSingleByChannel(
         HitResult,
         CameraLocation,
@@ -189,9 +230,22 @@ void UPhysicsGrabComponent::StartGrab()
         GrabOffset = HitResult.ImpactPoint - ObjectCenter;
         
         bIsGrabbing = true;
+        INC_DWORD_STAT(STAT_HeldItems);
         CurrentRotationPitch = 0.0f;
         CurrentRotationYaw = 0.0f;
 
+        if (GrabMode == EPhysicsGrabMode::Stack)
+        {
+            GatherStack();
+        }
+
+        // Results from the last object's arc say nothing about this one
+        for (float& Clear : PreviewSegmentClear)
+        {
+            Clear = 1.0f;
+        }
+        NextPreviewSegment = 0;
+
         if (GrabSound)
         {
             UGameplayStatics::PlaySound2D(GetWorld(), GrabSound);
@@ -208,6 +262,9 @@ void UPhysicsGrabComponent::StopGrab()
         return;
 
     bIsGrabbing = false;
+    DEC_DWORD_STAT(STAT_HeldItems);
+    HideThrowPreview();
+    ReleaseStack(FVector::ZeroVector);
     
     if (GrabbedActor)
     {
@@ -227,9 +284,22 @@ void UPhysicsGrabComponent::ThrowObject()
     if (!bIsGrabbing || !GrabbedComponent)
         return;
 
+    if (!GetPlayerCamera())
+        return;
+
+    // Released first so every body in the stack gets the same throw instead of just the one held
+    const FVector ThrowVelocity = GetThrowVelocity();
+    ReleaseStack(ThrowVelocity);
+    GrabbedComponent->AddImpulse(ThrowVelocity, NAME_None, true);
+
+    StopGrab();
+}
+
+FVector UPhysicsGrabComponent::GetThrowVelocity() const
+{
     UCameraComponent* Camera = GetPlayerCamera();
     if (!Camera)
-        return;
+        return FVector::ZeroVector;
 
     FVector ThrowDirection = Camera->GetForwardVector();
     FVector ThrowVelocity = ThrowDirection * ThrowForce;
@@ -239,9 +309,91 @@ void UPhysicsGrabComponent::ThrowObject()
         ThrowVelocity += PlayerCharacter->GetVelocity();
     }
 
-    GrabbedComponent->AddImpulse(ThrowVelocity, NAME_None, true);
+    return ThrowVelocity;
+}
 
-    StopGrab();
+void UPhysicsGrabComponent::UpdateThrowPreview()
+{
+    SCOPE_CYCLE_COUNTER(STAT_ThrowPreview);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPhysicsGrabComponent::UpdateThrowPreview);
+
+    if (!ThrowPreviewComponent || !GrabbedComponent || PreviewPoints.Num() < 2)
+        return;
+
+    // The throw is a velocity change on top of whatever the held object is already doing
+    const FVector Start = GrabbedComponent->GetComponentLocation();
+    const FVector Velocity = GrabbedComponent->GetPhysicsLinearVelocity() + GetThrowVelocity();
+    const FVector Gravity(0.0f, 0.0f, GetWorld()->GetGravityZ());
+
+    for (int32 Index = 0; Index < PreviewPoints.Num(); ++Index)
+    {
+        const float Time = Index * ThrowPreviewTimeStep;
+        PreviewPoints[Index] = Start + Velocity * Time + 0.5f * Gravity * Time * Time;
+    }
+
+    // Only a few segments are swept each frame; the rest keep a result a few frames old, which
+    // barely lags a smoothly moving aim
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ThrowPreview), false, GetOwner());
+    QueryParams.AddIgnoredActor(GrabbedActor);
+    for (const TWeakObjectPtr<UPrimitiveComponent>& Stacked : StackedComponents)
+    {
+        QueryParams.AddIgnoredComponent(Stacked.Get());
+    }
+    const FCollisionShape Shape = FCollisionShape::MakeSphere(GrabbedComponent->Bounds.BoxExtent.GetMin());
+
+    const int32 NumSegments = PreviewPoints.Num() - 1;
+    const int32 Sweeps = FMath::Min(ThrowPreviewSweepsPerFrame, NumSegments);
+    for (int32 i = 0; i < Sweeps; ++i)
+    {
+        if (NextPreviewSegment >= NumSegments)
+        {
+            NextPreviewSegment = 0;
+        }
+
+        FHitResult HitResult;
+        INC_DWORD_STAT(STAT_GameplayTraces);
+        const bool bHit = GetWorld()->SweepSingleByChannel(
+            HitResult,
+            PreviewPoints[NextPreviewSegment],
+            PreviewPoints[NextPreviewSegment + 1],
+            FQuat::Identity,
+            ECC_Visibility,
+            Shape,
+            QueryParams
+        );
+        PreviewSegmentClear[NextPreviewSegment] = bHit ? HitResult.Time : 1.0f;
+        ++NextPreviewSegment;
+    }
+
+    // The arc stops in the first segment known to be blocked
+    float EndTime = NumSegments * ThrowPreviewTimeStep;
+    for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+    {
+        if (PreviewSegmentClear[Segment] < 1.0f)
+        {
+            EndTime = (Segment + PreviewSegmentClear[Segment]) * ThrowPreviewTimeStep;
+            break;
+        }
+    }
+
+    if (EndTime <= KINDA_SMALL_NUMBER)
+    {
+        HideThrowPreview();
+        return;
+    }
+
+    // A cubic Hermite with these tangents is exactly the parabola, so one spline mesh draws the whole arc
+    const FVector End = Start + Velocity * EndTime + 0.5f * Gravity * EndTime * EndTime;
+    ThrowPreviewComponent->SetStartAndEnd(Start, Velocity * EndTime, End, (Velocity + Gravity * EndTime) * EndTime, true);
+    ThrowPreviewComponent->SetVisibility(true);
+}
+
+void UPhysicsGrabComponent::HideThrowPreview()
+{
+    if (ThrowPreviewComponent && ThrowPreviewComponent->IsVisible())
+    {
+        ThrowPreviewComponent->SetVisibility(false);
+    }
 }
 
 void UPhysicsGrabComponent::RotateGrabbedObject(float PitchInput, float YawInput)
@@ -303,19 +455,117 @@ bool UPhysicsGrabComponent::CanGrabObject(AActor* Actor, UPrimitiveComponent* Co
     if (!Actor || !Component)
         return false;
 
-    if (!Component->IsSimulatingPhysics())
+    if (Component->Mobility != EComponentMobility::Movable)
         return false;
 
-    float ObjectMass = Component->GetMass();
-    if (ObjectMass > MaxGrabMass)
+    if (!Component->IsSimulatingPhysics())
         return false;
 
-    if (Component->Mobility != EComponentMobility::Movable)
+    if (GetBodyMass(Actor, Component) > MaxGrabMass)
         return false;
 
     return true;
 }
 
+float UPhysicsGrabComponent::GetBodyMass(const AActor* Actor, const UPrimitiveComponent* Component) const
+{
+    // Runs on every trace hit; physics objects cache their mass at spawn
+    const APhysicsObject* PhysicsObj = Cast<APhysicsObject>(Actor);
+    return (PhysicsObj && PhysicsObj->ObjectMesh == Component) ? PhysicsObj->GetCachedMass() : Component->GetMass();
+}
+
+void UPhysicsGrabComponent::GatherStack()
+{
+    if (!GrabbedComponent || MaxStackedBodies <= 0)
+        return;
+
+    const FBoxSphereBounds Bounds = GrabbedComponent->Bounds;
+
+    TArray<FOverlapResult> Overlaps;
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(StackGrab), false, GetOwner());
+    QueryParams.AddIgnoredActor(GrabbedActor);
+
+    INC_DWORD_STAT(STAT_GameplayTraces);
+    GetWorld()->OverlapMultiByObjectType(
+        Overlaps,
+        Bounds.Origin,
+        FQuat::Identity,
+        FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllDynamicObjects),
+        FCollisionShape::MakeBox(Bounds.BoxExtent + FVector(StackSearchMargin)),
+        QueryParams
+    );
+
+    float StackMass = GetBodyMass(GrabbedActor, GrabbedComponent);
+
+    for (const FOverlapResult& Overlap : Overlaps)
+    {
+        if (StackedComponents.Num() >= MaxStackedBodies)
+            break;
+
+        AActor* Actor = Overlap.GetActor();
+        UPrimitiveComponent* Component = Overlap.GetComponent();
+
+        // Whole free-standing actors only, so attaching the component moves the actor with it
+        if (!Actor || !Component || Component != Actor->GetRootComponent() || Actor->GetAttachParentActor())
+            continue;
+
+        // Things resting on or beside the held body, not what it was sitting on
+        if (Component->GetComponentLocation().Z < Bounds.Origin.Z)
+            continue;
+
+        if (StackedComponents.Contains(Component) || !CanGrabObject(Actor, Component))
+            continue;
+
+        const float Mass = GetBodyMass(Actor, Component);
+        if (Mass > MaxStackedBodyMass || StackMass + Mass > MaxGrabMass)
+            continue;
+
+        // Welding merges its shapes into the held body, so the carried stack simulates as one body
+        Component->SetSimulatePhysics(false);
+        Component->AttachToComponent(GrabbedComponent, FAttachmentTransformRules(EAttachmentRule::KeepWorld, true));
+        StackedComponents.Add(Component);
+        StackMass += Mass;
+    }
+
+    INC_DWORD_STAT_BY(STAT_HeldItems, StackedComponents.Num());
+}
+
+void UPhysicsGrabComponent::ReleaseStack(const FVector& VelocityChange)
+{
+    if (StackedComponents.Num() == 0)
+        return;
+
+    DEC_DWORD_STAT_BY(STAT_HeldItems, StackedComponents.Num());
+
+    for (const TWeakObjectPtr<UPrimitiveComponent>& Stacked : StackedComponents)
+    {
+        UPrimitiveComponent* Component = Stacked.Get();
+        if (!Component)
+            continue;
+
+        // Taken off the stack while carried (e.g. picked up); whoever took it owns its physics now
+        USceneComponent* Parent = Component->GetAttachParent();
+        if (Parent && Parent != GrabbedComponent)
+            continue;
+
+        // Carry on with the motion the compound body had at this point
+        FVector Velocity = VelocityChange;
+        if (GrabbedComponent)
+        {
+            Velocity += GrabbedComponent->GetPhysicsLinearVelocityAtPoint(Component->GetComponentLocation());
+        }
+
+        if (Parent)
+        {
+            Component->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+        }
+        Component->SetSimulatePhysics(true);
+        Component->SetPhysicsLinearVelocity(Velocity);
+    }
+
+    StackedComponents.Reset();
+}
+
 FVector UPhysicsGrabComponent::GetGrabTargetLocation() const
 {
     UCameraComponent* Camera = GetPlayerCamera();
@@ -332,6 +582,9 @@ FVector UPhysicsGrabComponent::GetGrabTargetLocation() const
 
 void UPhysicsGrabComponent::ApplyGrabForce(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_PhysicsGrabForce);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPhysicsGrabComponent::ApplyGrabForce);
+
     if (!GrabbedComponent)
         return;
 
@@ -1,5 +1,7 @@
 #include "PhysicsObject.h"
-#include "Kismet/GameplayStatics.h"
+#include "ImpactAudioSubsystem.h"
+#include "PhysicsPropProfile.h"
+#include "GameFramework/Pawn.h"
 #include "Engine/World.h"
 
 APhysicsObject::APhysicsObject()
@@ -13,8 +15,60 @@ APhysicsObject::APhysicsObject()
     ObjectMesh->SetCollisionProfileName(TEXT("PhysicsActor"));
     ObjectMesh->SetLinearDamping(1.0f);
     ObjectMesh->SetAngularDamping(1.0f);
-    ObjectMesh->SetUseCCD(true); 
-    ObjectMesh->SetNotifyRigidBodyCollision(true);
+    // Only objects with a collision sound need hit events; BeginPlay turns them on for those
+    ObjectMesh->SetNotifyRigidBodyCollision(false);
+}
+
+void APhysicsObject::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+
+    // Baked into placed props here, so BeginPlay normally finds nothing left to change
+    ApplyPropProfile();
+}
+
+void APhysicsObject::ApplyPropProfile()
+{
+    if (!ObjectMesh)
+        return;
+
+    const UPhysicsPropProfile* Profile = PropProfile ? PropProfile : GetDefault<UPhysicsPropProfile>();
+    FBodyInstance& Body = ObjectMesh->BodyInstance;
+
+    // Updates the live body too, which a runtime spawn already has by the time OnConstruction runs
+    const bool bWantsCCD = Profile->NeedsCCD(ObjectMesh->Bounds.BoxExtent.GetMin());
+    if (Body.bUseCCD != bWantsCCD)
+    {
+        ObjectMesh->SetUseCCD(bWantsCCD);
+    }
+
+    if (Body.SleepFamily != Profile->SleepFamily || Body.CustomSleepThresholdMultiplier != Profile->SleepThresholdMultiplier)
+    {
+        Body.SleepFamily = Profile->SleepFamily;
+        Body.CustomSleepThresholdMultiplier = Profile->SleepThresholdMultiplier;
+
+        // Sleep thresholds are only read when the body is created
+        if (Body.IsValidBodyInstance())
+        {
+            ObjectMesh->RecreatePhysicsState();
+        }
+    }
+}
+
+bool APhysicsObject::IsRestingPlacedProp(const UPhysicsPropProfile& Profile) const
+{
+    // Spawned props were not placed at rest, whatever happens to be below them
+    if (!HasAnyFlags(RF_WasLoaded))
+        return false;
+
+    // Sweeps the body's own collision geometry, so a rotated prop beside a wall is not mistaken for one resting on a shelf
+    FComponentQueryParams Params(SCENE_QUERY_STAT(PhysicsObjectRestingContact), this);
+    const FVector Start = ObjectMesh->GetComponentLocation();
+    const FVector End = Start - FVector(0.0f, 0.0f, Profile.RestingContactTolerance);
+
+    TArray<FHitResult> Hits;
+    GetWorld()->ComponentSweepMulti(Hits, ObjectMesh, Start, End, ObjectMesh->GetComponentQuat(), Params);
+    return Hits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
 }
 
 void APhysicsObject::BeginPlay()
@@ -28,13 +82,59 @@ void APhysicsObject::BeginPlay()
     
     if (ObjectMesh)
     {
+        // The profile may have changed since the level was saved
+        ApplyPropProfile();
+
         ObjectMesh->SetMassOverrideInKg(NAME_None, ObjectMass);
+        CachedMass = ObjectMesh->GetMass();
+
+        const UPhysicsPropProfile* Profile = PropProfile ? PropProfile : GetDefault<UPhysicsPropProfile>();
+        if (Profile->bStartAsleep && IsRestingPlacedProp(*Profile))
+        {
+            ObjectMesh->PutRigidBodyToSleep();
+        }
     }
     
     if (ObjectMesh)
     {
         ObjectMesh->OnComponentHit.AddDynamic(this, &APhysicsObject::OnHit);
     }
+
+    SetCollisionSound(CollisionSound);
+}
+
+void APhysicsObject::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UImpactAudioSubsystem* ImpactAudio = UImpactAudioSubsystem::Get(this))
+    {
+        ImpactAudio->UnregisterHitSource(ObjectMesh);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void APhysicsObject::SetCollisionSound(USoundBase* NewSound)
+{
+    CollisionSound = NewSound;
+
+    if (!ObjectMesh)
+        return;
+
+    if (UImpactAudioSubsystem* ImpactAudio = UImpactAudioSubsystem::Get(this))
+    {
+        if (CollisionSound)
+        {
+            ImpactAudio->RegisterHitSource(ObjectMesh, HitNotifyCullDistance);
+        }
+        else
+        {
+            ImpactAudio->UnregisterHitSource(ObjectMesh);
+        }
+    }
+    else
+    {
+        ObjectMesh->SetNotifyRigidBodyCollision(CollisionSound != nullptr);
+    }
 }
 
 void APhysicsObject::Highlight(bool bHighlight)
@@ -68,12 +168,11 @@ void APhysicsObject::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPr
     if (OtherActor && OtherActor->IsA(APawn::StaticClass()))
         return;
     
-    UGameplayStatics::PlaySoundAtLocation(
-        GetWorld(),
-        CollisionSound,
-        GetActorLocation(),
-        FMath::Clamp(ImpactVelocity / 1000.0f, 0.1f, 1.0f)
-    );
+    // Batched with every other impact this frame; only the strongest few get a voice
+    if (UImpactAudioSubsystem* ImpactAudio = UImpactAudioSubsystem::Get(this))
+    {
+        ImpactAudio->QueueImpact(CollisionSound, GetActorLocation(), ImpactVelocity, FMath::Clamp(ImpactVelocity / 1000.0f, 0.1f, 1.0f), this);
+    }
     
     LastCollisionSoundTime = CurrentTime;
 }
\ No newline at end of file
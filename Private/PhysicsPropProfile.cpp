@@ -0,0 +1,15 @@
+#include "PhysicsPropProfile.h"
+
+bool UPhysicsPropProfile::NeedsCCD(float HalfThickness) const
+{
+    switch (CCDPolicy)
+    {
+    case EPhysicsPropCCD::Always:
+        return true;
+    case EPhysicsPropCCD::Never:
+        return false;
+    default:
+        // Moving further than half its own thickness in one step is where a body starts to skip through thin geometry
+        return HalfThickness <= 0.0f || MaxExpectedSpeed * SimulationStepTime > HalfThickness;
+    }
+}
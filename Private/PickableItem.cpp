@@ -1,6 +1,8 @@
 #include "PickableItem.h"
+#include "FirstPersonTest.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
+#include "GameplayActorRegistry.h"
 
 APickableItem::APickableItem()
 {
@@ -41,6 +43,31 @@ void APickableItem::BeginPlay()
     {
         DisplayName = FText::FromString(GetName());
     }
+
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Register<APickableItem>(this);
+    }
+
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->RegisterActor(this, TickSignificance);
+    }
+}
+
+void APickableItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Unregister<APickableItem>(this);
+    }
+
+    if (bIsHeld)
+    {
+        DEC_DWORD_STAT(STAT_HeldItems);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void APickableItem::Tick(float DeltaTime)
@@ -105,7 +132,16 @@ void APickableItem::PickUp(AActor* NewOwner, USceneComponent* AttachTo)
     bIsLerping = true;
     LerpAlpha = 0.0f;
 
+    if (!bIsHeld)
+    {
+        INC_DWORD_STAT(STAT_HeldItems);
+    }
     bIsHeld = true;
+
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->SetPinned(this, true);
+    }
 }
 
 void APickableItem::Drop(FVector DropImpulse)
@@ -141,6 +177,12 @@ void APickableItem::Drop(FVector DropImpulse)
     AttachComponent = nullptr;
 
     bIsHeld = false;
+    DEC_DWORD_STAT(STAT_HeldItems);
+
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->SetPinned(this, false);
+    }
 }
 
 void APickableItem::Highlight(bool bHighlight)
@@ -1,41 +1,54 @@
 // PlayerOxygenSystem.cpp
 #include "PlayerOxygenSystem.h"
+#include "FirstPersonTest.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/World.h"
 #include "Components/Image.h"
 #include "Engine/Engine.h"
+#include "HUDWidgetRegistry.h"
+#include "GameplayActorRegistry.h"
+#include "LevelTransitionSubsystem.h"
+#include "CheckpointSubsystem.h"
 
 APlayerOxygenSystem::APlayerOxygenSystem()
 {
 	PrimaryActorTick.bCanEverTick = true;
+
+	ScreenOverlayLayer.Caching = EHUDLayerCaching::None;
+	ScreenOverlayLayer.ZOrder = 1000; // High Z-order to appear on top
 }
 
 void APlayerOxygenSystem::BeginPlay()
 {
 	Super::BeginPlay();
 	
+	if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+	{
+		Registry->Register<APlayerOxygenSystem>(this);
+	}
+	
 	if (HUDWidgetClass)
 	{
 		APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
 		if (PC)
 		{
-			// First remove any existing widgets of this class
-			TArray<UUserWidget*> FoundWidgets;
-			for (TObjectIterator<UUserWidget> Itr; Itr; ++Itr)
+			// First release any stale widget of this class left over from a previous level
+			UHUDWidgetRegistry* Registry = UHUDWidgetRegistry::Get(PC);
+			if (Registry)
 			{
-				if (Itr->GetClass() == HUDWidgetClass)
-				{
-					Itr->RemoveFromParent();
-				}
+				Registry->ReleaseWidget(HUDWidgetClass);
 			}
 			
 			// Now create a fresh widget
-			HUDWidget = CreateWidget<UUserWidget>(PC, HUDWidgetClass);
+			HUDWidget = UHUDLayerLibrary::CreateHUDLayer(PC, HUDWidgetClass, HUDLayer);
 			if (HUDWidget)
 			{
-				HUDWidget->AddToViewport(0);
+				if (Registry)
+				{
+					Registry->RegisterWidget(HUDWidget);
+				}
 				
 				OxygenIcon = Cast<UImage>(HUDWidget->GetWidgetFromName(TEXT("Oxygen_Icon")));
 				OxygenLabel = Cast<UTextBlock>(HUDWidget->GetWidgetFromName(TEXT("Oxygen_Label")));
@@ -56,11 +69,9 @@ void APlayerOxygenSystem::BeginPlay()
 		APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
 		if (PC)
 		{
-			ScreenOverlayWidget = CreateWidget<UUserWidget>(PC, ScreenOverlayWidgetClass);
+			ScreenOverlayWidget = UHUDLayerLibrary::CreateHUDLayer(PC, ScreenOverlayWidgetClass, ScreenOverlayLayer);
 			if (ScreenOverlayWidget)
 			{
-				ScreenOverlayWidget->AddToViewport(1000); // High Z-order to appear on top
-				
 				// Find the screen tint image in the overlay widget
 				ScreenTintImage = Cast<UImage>(ScreenOverlayWidget->GetWidgetFromName(TEXT("ScreenTint_Image")));
 				
@@ -76,6 +87,16 @@ void APlayerOxygenSystem::BeginPlay()
 	}
 }
 
+void APlayerOxygenSystem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+	{
+		Registry->Unregister<APlayerOxygenSystem>(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
 void APlayerOxygenSystem::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -108,11 +129,30 @@ void APlayerOxygenSystem::AddOxygen(float Amount)
 	}
 }
 
+void APlayerOxygenSystem::RestoreOxygen(float Amount)
+{
+	CurrentOxygen = FMath::Clamp(Amount, 0.0f, MaxOxygen);
+	
+	bGameOverTriggered = false;
+	GetWorldTimerManager().ClearTimer(GameOverTimerHandle);
+	
+	UpdateHUD();
+	UpdateScreenTint();
+}
+
 void APlayerOxygenSystem::UpdateHUD()
 {
+	CSV_SCOPED_TIMING_STAT(GameplayUI, OxygenHUD);
+
 	if (OxygenIcon && OxygenLabel)
 	{
 		int32 OxygenPercentage = FMath::RoundToInt((CurrentOxygen / MaxOxygen) * 100.0f);
+		if (OxygenPercentage == LastDisplayedOxygenPercentage)
+		{
+			return;
+		}
+		LastDisplayedOxygenPercentage = OxygenPercentage;
+
 		FString OxygenText = FString::Printf(TEXT("%d%%"), OxygenPercentage);
 		
 		OxygenLabel->SetText(FText::FromString(OxygenText));
@@ -196,6 +236,16 @@ void APlayerOxygenSystem::RestartGame()
 {
 	UE_LOG(LogTemp, Warning, TEXT("Restarting game due to oxygen depletion..."));
 	
+	// Restore in place when restarting the current level, keeping widgets and loaded assets
+	if (bRestartFromCheckpoint && RestartLevelName.IsNone())
+	{
+		UCheckpointSubsystem* Checkpoints = UCheckpointSubsystem::Get(this);
+		if (Checkpoints && Checkpoints->RestoreCheckpoint())
+		{
+			return;
+		}
+	}
+	
 	// Clean up widgets before restart
 	if (HUDWidget)
 	{
@@ -207,7 +257,8 @@ void APlayerOxygenSystem::RestartGame()
 	}
 	
 	// Restart the level
-	if (RestartLevelName.IsNone())
+	FName LevelToOpen = RestartLevelName;
+	if (LevelToOpen.IsNone())
 	{
 		// Restart current level by getting current level name
 		FString CurrentLevelName = GetWorld()->GetMapName();
@@ -217,11 +268,15 @@ void APlayerOxygenSystem::RestartGame()
 		{
 			CurrentLevelName = CurrentLevelName.RightChop(LastSlash + 1);
 		}
-		UGameplayStatics::OpenLevel(this, FName(*CurrentLevelName));
+		LevelToOpen = FName(*CurrentLevelName);
+	}
+	
+	if (ULevelTransitionSubsystem* Transition = ULevelTransitionSubsystem::Get(this))
+	{
+		Transition->TravelToLevel(LevelToOpen);
 	}
 	else
 	{
-		// Load specific level
-		UGameplayStatics::OpenLevel(this, RestartLevelName);
+		UGameplayStatics::OpenLevel(this, LevelToOpen);
 	}
 }
\ No newline at end of file
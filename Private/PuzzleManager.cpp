@@ -1,4 +1,5 @@
 ﻿#include "PuzzleManager.h"
+#include "FirstPersonTest.h"
 #include "P_FixableMachine.h"
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
@@ -6,6 +7,12 @@
 #include "Kismet/GameplayStatics.h"
 #include "Components/PointLightComponent.h"
 #include "Engine/PointLight.h"
+#include "GameplayActorRegistry.h"
+#include "CheckpointSubsystem.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/LevelBounds.h"
+#include "TimerManager.h"
+#include "Misc/PackageName.h"
 
 APuzzleManager::APuzzleManager()
 {
@@ -17,7 +24,6 @@ APuzzleManager::APuzzleManager()
     InteractLabel = nullptr;
     ObjectiveLabel = nullptr;
     TaskLabel = nullptr;
-    CurrentHighlightedMachine = nullptr;
 }
 
 APuzzleManager::~APuzzleManager()
@@ -38,7 +44,6 @@ APuzzleManager::~APuzzleManager()
     InteractLabel = nullptr;
     ObjectiveLabel = nullptr;
     TaskLabel = nullptr;
-    CurrentHighlightedMachine = nullptr;
 }
 
 void APuzzleManager::BeginPlay()
@@ -51,12 +56,33 @@ void APuzzleManager::BeginPlay()
     RegisterMachines();
     UpdatePointLights();
     
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Register<APuzzleManager>(this);
+    }
+    
     if (PuzzleData.Num() > 0)
     {
         PuzzleData[0].bIsActive = true;
         UpdatePlayerHUDLabels();
     }
     
+    RoomStreamingLevels.SetNum(PuzzleData.Num());
+    RoomBounds.Init(FBox(ForceInit), PuzzleData.Num());
+    for (int32 i = 0; i < PuzzleData.Num(); ++i)
+    {
+        if (!PuzzleData[i].RoomLevel.IsNull())
+        {
+            const FString PackageName = FPackageName::ObjectPathToPackageName(PuzzleData[i].RoomLevel.ToString());
+            RoomStreamingLevels[i] = UGameplayStatics::GetStreamingLevel(this, FName(*PackageName));
+            if (!RoomStreamingLevels[i])
+            {
+                UE_LOG(LogTemp, Warning, TEXT("PuzzleManager: Room %s is not a streaming level of this map"), *PackageName);
+            }
+        }
+    }
+    UpdateRoomStreaming();
+    
     for (FPointLightData& LightData : PointLights)
     {
         if (LightData.PointLight && IsValid(LightData.PointLight))
@@ -76,8 +102,21 @@ void APuzzleManager::BeginPlay()
     }
 }
 
+void APuzzleManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UGameplayActorRegistry* Registry = UGameplayActorRegistry::Get(this))
+    {
+        Registry->Unregister<APuzzleManager>(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
 void APuzzleManager::Tick(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_PuzzleManagerTick);
+    TRACE_CPUPROFILER_EVENT_SCOPE(APuzzleManager::Tick);
+
     Super::Tick(DeltaTime);
     
     if (bUseInterpolation)
@@ -107,11 +146,9 @@ void APuzzleManager::InitializeHUD()
         APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
         if (PC)
         {
-            HUDWidget = CreateWidget<UUserWidget>(PC, HUDWidgetClass);
+            HUDWidget = UHUDLayerLibrary::CreateHUDLayer(PC, HUDWidgetClass, HUDLayer);
             if (HUDWidget)
             {
-                HUDWidget->AddToViewport();
-
                 ProgressBar = Cast<UProgressBar>(HUDWidget->GetWidgetFromName(TEXT("ProgressBar")));
                 InteractLabel = Cast<UTextBlock>(HUDWidget->GetWidgetFromName(TEXT("InteractLabel")));
 
@@ -136,11 +173,9 @@ void APuzzleManager::InitializePlayerHUD()
         APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
         if (PC)
         {
-            PlayerHUDWidget = CreateWidget<UUserWidget>(PC, PlayerHUDWidgetClass);
+            PlayerHUDWidget = UHUDLayerLibrary::CreateHUDLayer(PC, PlayerHUDWidgetClass, PlayerHUDLayer);
             if (PlayerHUDWidget)
             {
-                PlayerHUDWidget->AddToViewport();
-
                 ObjectiveLabel = Cast<UTextBlock>(PlayerHUDWidget->GetWidgetFromName(TEXT("objective_label")));
                 TaskLabel = Cast<UTextBlock>(PlayerHUDWidget->GetWidgetFromName(TEXT("task_label")));
             }
@@ -150,6 +185,8 @@ void APuzzleManager::InitializePlayerHUD()
 
 void APuzzleManager::RegisterMachines()
 {
+    ResolveRoomMachines();
+    
     for (int32 i = 0; i < PuzzleData.Num(); ++i)
     {
         if (PuzzleData[i].Machine && IsValid(PuzzleData[i].Machine))
@@ -194,6 +231,7 @@ void APuzzleManager::OnMachineFixed(AP_FixableMachine* Machine)
         UpdatePointLightForPuzzle(PuzzleIndex, 100.0f);
         
         ActivateNextPuzzle();
+        UpdateRoomStreaming();
     }
 
     if (ProgressBar && IsValid(ProgressBar))
@@ -222,10 +260,18 @@ void APuzzleManager::OnMachineFixed(AP_FixableMachine* Machine)
     {
         OnAllMachinesFixed();
     }
+
+    // A solved puzzle is progress worth keeping across a death restart
+    if (UCheckpointSubsystem* Checkpoints = UCheckpointSubsystem::Get(this))
+    {
+        Checkpoints->CaptureCheckpoint();
+    }
 }
 
-void APuzzleManager::UpdateFixingProgress(float Progress)
+void APuzzleManager::UpdateFixingProgress(AP_FixableMachine* Machine, float Progress)
 {
+    CSV_SCOPED_TIMING_STAT(GameplayUI, PuzzleProgress);
+
     if (!VerifyWidgets()) return;
 
     if (ProgressBar)
@@ -234,15 +280,18 @@ void APuzzleManager::UpdateFixingProgress(float Progress)
         ProgressBar->SetPercent(Progress);
     }
 
-    AP_FixableMachine* CurrentMachine = CurrentHighlightedMachine;
-    if (CurrentMachine)
+    int32 PuzzleIndex = FindPuzzleIndex(Machine);
+    if (PuzzleIndex != -1)
     {
-        int32 PuzzleIndex = FindPuzzleIndex(CurrentMachine);
-        if (PuzzleIndex != -1)
+        const float PreviousCompletion = PuzzleData[PuzzleIndex].CompletionPercentage;
+        PuzzleData[PuzzleIndex].CompletionPercentage = Progress * 100.0f;
+        UpdatePointLightForPuzzle(PuzzleIndex, Progress * 100.0f);
+        CalculateGlobalProgression();
+        
+        // Crossing the threshold in either direction changes whether the next room should be resident
+        if ((PreviousCompletion >= StreamNextRoomAtCompletion) != (PuzzleData[PuzzleIndex].CompletionPercentage >= StreamNextRoomAtCompletion))
         {
-            PuzzleData[PuzzleIndex].CompletionPercentage = Progress * 100.0f;
-            UpdatePointLightForPuzzle(PuzzleIndex, Progress * 100.0f);
-            CalculateGlobalProgression();
+            UpdateRoomStreaming();
         }
     }
 }
@@ -332,6 +381,35 @@ void APuzzleManager::ActivateNextPuzzle()
     }
 }
 
+void APuzzleManager::RefreshRestoredState(int32 InCurrentPuzzleIndex)
+{
+    CurrentPuzzleIndex = InCurrentPuzzleIndex;
+    UpdateRoomStreaming();
+    CalculateGlobalProgression();
+    UpdatePointLights();
+    HideProgressBar();
+    ShowInteractionUI(false);
+
+    bool bAllFixed = PuzzleData.Num() > 0;
+    for (const FPuzzleData& Puzzle : PuzzleData)
+    {
+        if (!Puzzle.bIsCompleted)
+        {
+            bAllFixed = false;
+            break;
+        }
+    }
+
+    if (bAllFixed)
+    {
+        OnAllMachinesFixed();
+    }
+    else
+    {
+        UpdatePlayerHUDLabels();
+    }
+}
+
 void APuzzleManager::CalculateGlobalProgression()
 {
     if (PuzzleData.Num() == 0)
@@ -454,4 +532,136 @@ void APuzzleManager::SortPuzzlesByOrder()
     PuzzleData.Sort([](const FPuzzleData& A, const FPuzzleData& B) {
         return A.PuzzleOrder < B.PuzzleOrder;
     });
+}
+
+void APuzzleManager::UpdateRoomStreaming()
+{
+    // Mirrors ActivateNextPuzzle: the next puzzle is the first one neither solved nor active
+    int32 NextPuzzleIndex = INDEX_NONE;
+    bool bActivePastThreshold = true;
+    for (int32 i = 0; i < PuzzleData.Num(); ++i)
+    {
+        if (PuzzleData[i].bIsActive && PuzzleData[i].CompletionPercentage < StreamNextRoomAtCompletion)
+        {
+            bActivePastThreshold = false;
+        }
+        if (NextPuzzleIndex == INDEX_NONE && !PuzzleData[i].bIsCompleted && !PuzzleData[i].bIsActive)
+        {
+            NextPuzzleIndex = i;
+        }
+    }
+
+    bool bUnloadDeferred = false;
+    for (int32 i = 0; i < RoomStreamingLevels.Num() && i < PuzzleData.Num(); ++i)
+    {
+        const FPuzzleData& Puzzle = PuzzleData[i];
+
+        bool bWanted;
+        if (Puzzle.bIsCompleted)
+        {
+            // The player is usually still standing in the room they just solved; it goes once they leave
+            bWanted = Puzzle.bKeepRoomLoadedWhenComplete;
+            if (!bWanted && IsPlayerInRoom(i))
+            {
+                bWanted = true;
+                bUnloadDeferred = true;
+            }
+        }
+        else if (Puzzle.bIsActive)
+        {
+            bWanted = true;
+        }
+        else
+        {
+            bWanted = i == NextPuzzleIndex && bActivePastThreshold;
+        }
+
+        SetRoomLoaded(i, bWanted);
+    }
+
+    FTimerManager& TimerManager = GetWorldTimerManager();
+    if (bUnloadDeferred && !TimerManager.IsTimerActive(RoomUnloadCheckTimer))
+    {
+        TimerManager.SetTimer(RoomUnloadCheckTimer, this, &APuzzleManager::UpdateRoomStreaming, 0.5f, true);
+    }
+    else if (!bUnloadDeferred)
+    {
+        TimerManager.ClearTimer(RoomUnloadCheckTimer);
+    }
+}
+
+bool APuzzleManager::IsPlayerInRoom(int32 PuzzleIndex)
+{
+    ULevelStreaming* StreamingLevel = RoomStreamingLevels.IsValidIndex(PuzzleIndex) ? RoomStreamingLevels[PuzzleIndex] : nullptr;
+    ULevel* Level = StreamingLevel ? StreamingLevel->GetLoadedLevel() : nullptr;
+    APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(this, 0);
+    if (!Level || !PlayerPawn)
+    {
+        return false;
+    }
+
+    FBox& Bounds = RoomBounds[PuzzleIndex];
+    if (!Bounds.IsValid)
+    {
+        Bounds = ALevelBounds::CalculateLevelBounds(Level);
+    }
+
+    return Bounds.ExpandBy(RoomExitMargin).IsInside(PlayerPawn->GetActorLocation());
+}
+
+void APuzzleManager::SetRoomLoaded(int32 PuzzleIndex, bool bLoaded)
+{
+    ULevelStreaming* StreamingLevel = RoomStreamingLevels.IsValidIndex(PuzzleIndex) ? RoomStreamingLevels[PuzzleIndex] : nullptr;
+    if (!StreamingLevel || StreamingLevel->ShouldBeLoaded() == bLoaded)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("PuzzleManager: %s room for puzzle %d"), bLoaded ? TEXT("Streaming in") : TEXT("Unloading"), PuzzleIndex);
+
+    if (bLoaded)
+    {
+        StreamingLevel->OnLevelShown.AddUniqueDynamic(this, &APuzzleManager::OnRoomLevelShown);
+        StreamingLevel->SetShouldBeLoaded(true);
+        StreamingLevel->SetShouldBeVisible(true);
+    }
+    else
+    {
+        // The machine goes away with its room
+        FPuzzleData& Puzzle = PuzzleData[PuzzleIndex];
+        if (!Puzzle.RoomMachine.IsNull())
+        {
+            Puzzle.Machine = nullptr;
+        }
+
+        RoomBounds[PuzzleIndex] = FBox(ForceInit);
+        StreamingLevel->SetShouldBeVisible(false);
+        StreamingLevel->SetShouldBeLoaded(false);
+    }
+}
+
+void APuzzleManager::ResolveRoomMachines()
+{
+    for (FPuzzleData& Puzzle : PuzzleData)
+    {
+        if (Puzzle.Machine || Puzzle.RoomMachine.IsNull())
+        {
+            continue;
+        }
+
+        if (AP_FixableMachine* Machine = Puzzle.RoomMachine.Get())
+        {
+            Puzzle.Machine = Machine;
+            Machine->SetPuzzleManager(this);
+            if (Puzzle.bIsCompleted)
+            {
+                Machine->RestoreState(1.0f, true);
+            }
+        }
+    }
+}
+
+void APuzzleManager::OnRoomLevelShown()
+{
+    ResolveRoomMachines();
 }
\ No newline at end of file
@@ -0,0 +1,181 @@
+#include "InteractionBenchmarkSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Run headless with:
+//   UE4Editor FirstPersonTest -game -nullrhi -ExecCmds="Automation RunTests FirstPersonTest; Quit"
+
+namespace InteractionBenchmarkTests
+{
+    // Real seconds to wait for the opened map to possess a pawn
+    constexpr double PawnTimeoutSeconds = 30.0;
+    // Real seconds a full run may take; it simulates PathLapTime * PathLaps at the fixed step
+    constexpr double RunTimeoutSeconds = 600.0;
+
+    // Stands in for the map list when none is configured, so the missing config fails loudly instead of running nothing
+    const TCHAR* const NoBudgetsConfigured = TEXT("NoBudgetsConfigured");
+
+    UWorld* FindGameWorld()
+    {
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World())
+            {
+                return Context.World();
+            }
+        }
+        return nullptr;
+    }
+}
+
+// Starts a run as soon as the freshly opened map has a possessed player pawn
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FStartInteractionBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FStartInteractionBenchmarkCommand::Update()
+{
+    UWorld* World = InteractionBenchmarkTests::FindGameWorld();
+    APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+    if (!PC || !PC->GetPawn())
+    {
+        if (GetCurrentRunTime() > InteractionBenchmarkTests::PawnTimeoutSeconds)
+        {
+            Test->AddError(TEXT("Timed out waiting for a possessed player pawn"));
+            return true;
+        }
+        return false;
+    }
+
+    UInteractionBenchmarkSubsystem* Benchmark = UInteractionBenchmarkSubsystem::Get(World);
+    if (!Benchmark)
+    {
+        Test->AddError(TEXT("No interaction benchmark subsystem in the game world"));
+        return true;
+    }
+
+    Benchmark->StartBenchmark(false);
+    Test->TestTrue(TEXT("Benchmark started"), Benchmark->IsRunning());
+    return true;
+}
+
+// Waits for the run to finish on its own, then checks what it recorded against the map's budget
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FCheckInteractionBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FCheckInteractionBenchmarkCommand::Update()
+{
+    UWorld* World = InteractionBenchmarkTests::FindGameWorld();
+    UInteractionBenchmarkSubsystem* Benchmark = UInteractionBenchmarkSubsystem::Get(World);
+    if (!Benchmark)
+    {
+        Test->AddError(TEXT("The game world went away during the run"));
+        return true;
+    }
+
+    if (Benchmark->IsRunning())
+    {
+        if (GetCurrentRunTime() <= InteractionBenchmarkTests::RunTimeoutSeconds)
+        {
+            return false;
+        }
+        Test->AddError(TEXT("Timed out waiting for the benchmark to finish"));
+        Benchmark->StopBenchmark();
+    }
+
+    if (!Test->TestTrue(TEXT("Benchmark produced a result"), Benchmark->HasResult()))
+    {
+        return true;
+    }
+
+    const FInteractionBenchmarkResult& Result = Benchmark->GetLastResult();
+    Test->TestTrue(TEXT("Frames were recorded"), Result.Frames > 0);
+    Test->TestEqual(TEXT("Whole population spawned"), Result.SpawnedActors, Benchmark->GetConfiguredPopulation());
+    Test->TestTrue(FString::Printf(TEXT("Median %.2f ms within %.2f ms"), Result.MedianMs, Result.Budget.MedianFrameMs), Result.MedianMs <= Result.Budget.MedianFrameMs);
+    Test->TestTrue(FString::Printf(TEXT("P95 %.2f ms within %.2f ms"), Result.P95Ms, Result.Budget.P95FrameMs), Result.P95Ms <= Result.Budget.P95FrameMs);
+    Test->TestTrue(FString::Printf(TEXT("P99 %.2f ms within %.2f ms"), Result.P99Ms, Result.Budget.P99FrameMs), Result.P99Ms <= Result.Budget.P99FrameMs);
+    Test->TestTrue(FString::Printf(TEXT("%d ticking actors within %d"), Result.MaxTickingActors, Result.Budget.MaxTickingActors), Result.MaxTickingActors <= Result.Budget.MaxTickingActors);
+    return true;
+}
+
+// One test per map that has a budget configured, e.g. FirstPersonTest.InteractionBenchmark.Budget.Level_01
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FInteractionBenchmarkBudgetTest, "FirstPersonTest.InteractionBenchmark.Budget",
+    EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+void FInteractionBenchmarkBudgetTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    TArray<FString> Maps = GetDefault<UInteractionBenchmarkSubsystem>()->GetBudgetedMaps();
+    if (Maps.Num() == 0)
+    {
+        Maps.Add(InteractionBenchmarkTests::NoBudgetsConfigured);
+    }
+
+    for (const FString& Map : Maps)
+    {
+        OutBeautifiedNames.Add(Map);
+        OutTestCommands.Add(Map);
+    }
+}
+
+bool FInteractionBenchmarkBudgetTest::RunTest(const FString& Parameters)
+{
+    if (Parameters == InteractionBenchmarkTests::NoBudgetsConfigured)
+    {
+        AddError(TEXT("No map budgets configured; add DefaultBudget or MapBudgets entries under [/Script/FirstPersonTest.InteractionBenchmarkSubsystem] in DefaultGame.ini"));
+        return false;
+    }
+
+    if (!AutomationOpenMap(Parameters))
+    {
+        AddError(FString::Printf(TEXT("Could not open %s"), *Parameters));
+        return false;
+    }
+
+    ADD_LATENT_AUTOMATION_COMMAND(FStartInteractionBenchmarkCommand(this));
+    ADD_LATENT_AUTOMATION_COMMAND(FCheckInteractionBenchmarkCommand(this));
+    return true;
+}
+
+// The percentile and budget check on synthetic frames, so it needs no map
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInteractionBenchmarkEvaluateTest, "FirstPersonTest.InteractionBenchmark.EvaluateBudget",
+    EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FInteractionBenchmarkEvaluateTest::RunTest(const FString& Parameters)
+{
+    FMapPerformanceBudget Budget;
+    Budget.MedianFrameMs = 10.0f;
+    Budget.P95FrameMs = 15.0f;
+    Budget.P99FrameMs = 20.0f;
+    Budget.MaxTickingActors = 100;
+
+    // 1..100 ms in shuffled order, so the evaluation has to sort
+    TArray<float> FrameTimes;
+    for (int32 i = 0; i < 100; ++i)
+    {
+        FrameTimes.Add((float)((i * 37) % 100 + 1));
+    }
+
+    const FInteractionBenchmarkResult Over = UInteractionBenchmarkSubsystem::EvaluateBudget(FrameTimes, 50, Budget);
+    TestEqual(TEXT("Frame count"), Over.Frames, 100);
+    TestEqual(TEXT("Median"), Over.MedianMs, 51.0f);
+    TestEqual(TEXT("P95"), Over.P95Ms, 96.0f);
+    TestEqual(TEXT("P99"), Over.P99Ms, 100.0f);
+    TestFalse(TEXT("Slow frames exceed the budget"), Over.bWithinBudget);
+
+    TArray<float> FastFrames;
+    FastFrames.Init(5.0f, 100);
+    const FInteractionBenchmarkResult Within = UInteractionBenchmarkSubsystem::EvaluateBudget(FastFrames, 100, Budget);
+    TestTrue(TEXT("Fast frames are within the budget"), Within.bWithinBudget);
+
+    const FInteractionBenchmarkResult TooManyTicking = UInteractionBenchmarkSubsystem::EvaluateBudget(FastFrames, 101, Budget);
+    TestFalse(TEXT("Ticking actor limit is enforced"), TooManyTicking.bWithinBudget);
+
+    const FInteractionBenchmarkResult Empty = UInteractionBenchmarkSubsystem::EvaluateBudget(TArray<float>(), 0, Budget);
+    TestEqual(TEXT("No frames"), Empty.Frames, 0);
+    TestTrue(TEXT("An empty run is not a failure"), Empty.bWithinBudget);
+    return true;
+}
+
+#endif
@@ -0,0 +1,195 @@
+#include "TickSignificanceSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+
+void UTickSignificanceSubsystem::Deinitialize()
+{
+    Entries.Empty();
+    IndexByActor.Empty();
+
+    Super::Deinitialize();
+}
+
+UTickSignificanceSubsystem* UTickSignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    return World ? World->GetSubsystem<UTickSignificanceSubsystem>() : nullptr;
+}
+
+void UTickSignificanceSubsystem::RegisterActor(AActor* Actor, const FTickSignificanceSettings& Settings)
+{
+    if (!Actor || IndexByActor.Contains(Actor))
+    {
+        return;
+    }
+
+    FEntry& Entry = Entries.AddDefaulted_GetRef();
+    Entry.Key = Actor;
+    Entry.Actor = Actor;
+    Entry.Settings = Settings;
+    Entry.OriginalTickInterval = Actor->GetActorTickInterval();
+    Entry.bOwnerTickEnabled = Actor->IsActorTickEnabled();
+    IndexByActor.Add(Actor, Entries.Num() - 1);
+    ++BucketCounts[static_cast<int32>(ETickSignificance::Full)];
+}
+
+void UTickSignificanceSubsystem::UnregisterActor(AActor* Actor)
+{
+    if (const int32* Index = IndexByActor.Find(Actor))
+    {
+        // Hand the actor back in its normal ticking state
+        ApplyBucket(Entries[*Index], ETickSignificance::Full);
+        RemoveAt(*Index);
+    }
+}
+
+void UTickSignificanceSubsystem::RemoveAt(int32 Index)
+{
+    --BucketCounts[static_cast<int32>(Entries[Index].Bucket)];
+    IndexByActor.Remove(Entries[Index].Key);
+
+    Entries.RemoveAtSwap(Index, 1, false);
+    if (Entries.IsValidIndex(Index))
+    {
+        IndexByActor.Add(Entries[Index].Key, Index);
+    }
+}
+
+void UTickSignificanceSubsystem::SetPinned(AActor* Actor, bool bPinned)
+{
+    if (const int32* Index = IndexByActor.Find(Actor))
+    {
+        FEntry& Entry = Entries[*Index];
+        Entry.bPinned = bPinned;
+        if (bPinned)
+        {
+            ApplyBucket(Entry, ETickSignificance::Full);
+        }
+    }
+}
+
+ETickSignificance UTickSignificanceSubsystem::GetSignificance(const AActor* Actor) const
+{
+    const int32* Index = IndexByActor.Find(Actor);
+    return Index ? Entries[*Index].Bucket : ETickSignificance::Full;
+}
+
+void UTickSignificanceSubsystem::Tick(float DeltaTime)
+{
+    APlayerController* PC = GetWorld()->GetFirstPlayerController();
+    if (!PC || Entries.Num() == 0)
+    {
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    const FVector ViewDirection = ViewRotation.Vector();
+
+    const int32 Budget = FMath::Min(ActorsEvaluatedPerFrame, Entries.Num());
+    for (int32 i = 0; i < Budget && Entries.Num() > 0; ++i)
+    {
+        if (NextEntryToEvaluate >= Entries.Num())
+        {
+            NextEntryToEvaluate = 0;
+        }
+
+        if (!Entries[NextEntryToEvaluate].Actor.IsValid())
+        {
+            // Destroyed without unregistering; the swapped-in entry is evaluated next
+            RemoveAt(NextEntryToEvaluate);
+            continue;
+        }
+
+        Evaluate(Entries[NextEntryToEvaluate], ViewLocation, ViewDirection);
+        ++NextEntryToEvaluate;
+    }
+}
+
+void UTickSignificanceSubsystem::Evaluate(FEntry& Entry, const FVector& ViewLocation, const FVector& ViewDirection)
+{
+    if (Entry.bPinned)
+    {
+        ApplyBucket(Entry, ETickSignificance::Full);
+        return;
+    }
+
+    const FVector ToActor = Entry.Actor->GetActorLocation() - ViewLocation;
+    float Distance = ToActor.Size();
+    if ((ToActor | ViewDirection) < 0.0f)
+    {
+        Distance *= Entry.Settings.BehindViewDistanceScale;
+    }
+
+    // Dropping to a cheaper bucket needs the threshold exceeded by the hysteresis margin
+    const float Margin = 1.0f + Hysteresis;
+    const float FullLimit = Entry.Settings.FullTickDistance * (Entry.Bucket == ETickSignificance::Full ? Margin : 1.0f);
+    const float ReducedLimit = Entry.Settings.ReducedTickDistance * (Entry.Bucket != ETickSignificance::Dormant ? Margin : 1.0f);
+
+    ETickSignificance NewBucket = ETickSignificance::Dormant;
+    if (Distance <= FullLimit)
+    {
+        NewBucket = ETickSignificance::Full;
+    }
+    else if (Distance <= ReducedLimit || !Entry.Settings.bAllowDormant)
+    {
+        NewBucket = ETickSignificance::Reduced;
+    }
+
+    ApplyBucket(Entry, NewBucket);
+}
+
+void UTickSignificanceSubsystem::ApplyBucket(FEntry& Entry, ETickSignificance NewBucket)
+{
+    if (Entry.Bucket == NewBucket)
+    {
+        return;
+    }
+
+    AActor* Actor = Entry.Actor.Get();
+    if (Actor)
+    {
+        if (Entry.Bucket == ETickSignificance::Dormant)
+        {
+            // Leaving dormancy: back to the actor's own state, or on if it re-enabled itself meanwhile
+            Actor->SetActorTickEnabled(Entry.bOwnerTickEnabled || Actor->IsActorTickEnabled());
+        }
+        else if (NewBucket == ETickSignificance::Dormant)
+        {
+            // Outside dormancy the enabled flag is only ever set by the actor itself
+            Entry.bOwnerTickEnabled = Actor->IsActorTickEnabled();
+            Actor->SetActorTickEnabled(false);
+        }
+
+        if (NewBucket == ETickSignificance::Reduced)
+        {
+            Actor->SetActorTickInterval(FMath::Max(Entry.OriginalTickInterval, Entry.Settings.ReducedTickInterval));
+        }
+        else if (NewBucket == ETickSignificance::Full)
+        {
+            Actor->SetActorTickInterval(Entry.OriginalTickInterval);
+        }
+    }
+
+    --BucketCounts[static_cast<int32>(Entry.Bucket)];
+    ++BucketCounts[static_cast<int32>(NewBucket)];
+    Entry.Bucket = NewBucket;
+}
+
+TStatId UTickSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UTickSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType UTickSignificanceSubsystem::GetTickableTickType() const
+{
+    // The class default object must never tick
+    return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UTickSignificanceSubsystem::IsTickable() const
+{
+    return GetWorld() && GetWorld()->HasBegunPlay();
+}
@@ -2,6 +2,7 @@
 // Implementation of the timer widget that changes color as time runs out
 
 #include "TimerWidget.h"
+#include "FirstPersonTest.h"
 #include "Components/TextBlock.h"
 #include "Kismet/KismetTextLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -13,6 +14,8 @@ void UTimerWidget::NativeConstruct()
     
     // Initialize timer
     CurrentTime = InitialTime;
+    LastDisplayedValue = INDEX_NONE;
+    bColorDirty = true;
     
     // Initialize timer display
     UpdateTimerDisplay();
@@ -20,6 +23,8 @@ void UTimerWidget::NativeConstruct()
 
 void UTimerWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
+    CSV_SCOPED_TIMING_STAT(GameplayUI, TimerWidget);
+
     Super::NativeTick(MyGeometry, InDeltaTime);
     
     if (bIsActive)
@@ -59,6 +64,8 @@ void UTimerWidget::PauseTimer()
 void UTimerWidget::ResetTimer()
 {
     CurrentTime = InitialTime;
+    LastDisplayedValue = INDEX_NONE;
+    bColorDirty = true;
     UpdateTimerDisplay();
 }
 
@@ -80,55 +87,102 @@ void UTimerWidget::UpdateTimerDisplay()
         return;
     }
     
-    // Calculate minutes and seconds
-    int32 TotalSeconds = FMath::FloorToInt(CurrentTime);
-    int32 Minutes = TotalSeconds / 60;
-    int32 Seconds = TotalSeconds % 60;
+    // Only touch the text block when the visible digits change
+    const int32 TotalHundredths = FMath::FloorToInt(CurrentTime * 100.0f);
+    const int32 DisplayedValue = bShowMilliseconds ? TotalHundredths : TotalHundredths / 100;
     
-    FString TimeString;
+    if (DisplayedValue != LastDisplayedValue || bShowMilliseconds != bLastShowMilliseconds)
+    {
+        LastDisplayedValue = DisplayedValue;
+        bLastShowMilliseconds = bShowMilliseconds;
+        
+        FormatTime(TotalHundredths);
+        TimerText->SetText(FText::AsCultureInvariant(TimeStringBuffer));
+    }
     
-    if (bShowMilliseconds)
+    UpdateTimerColor();
+}
+
+void UTimerWidget::FormatTime(int32 TotalHundredths)
+{
+    const int32 TotalSeconds = TotalHundredths / 100;
+    const int32 Minutes = TotalSeconds / 60;
+    const int32 Seconds = TotalSeconds % 60;
+    
+    // "mm" (at least two digits) + ":ss" + ".hh"
+    TCHAR Buffer[16];
+    int32 Len = 0;
+    
+    TCHAR MinuteDigits[10];
+    int32 NumMinuteDigits = 0;
+    int32 RemainingMinutes = Minutes;
+    do
     {
-        // Include milliseconds
-        int32 Milliseconds = FMath::FloorToInt((CurrentTime - TotalSeconds) * 100);
-        TimeString = FString::Printf(TEXT("%02d:%02d.%02d"), Minutes, Seconds, Milliseconds);
+        MinuteDigits[NumMinuteDigits++] = TEXT('0') + (RemainingMinutes % 10);
+        RemainingMinutes /= 10;
     }
-    else
+    while (RemainingMinutes > 0 && NumMinuteDigits < UE_ARRAY_COUNT(MinuteDigits));
+    
+    if (NumMinuteDigits < 2)
     {
-        // Format as mm:ss
-        TimeString = FString::Printf(TEXT("%02d:%02d"), Minutes, Seconds);
+        Buffer[Len++] = TEXT('0');
+    }
+    while (NumMinuteDigits > 0)
+    {
+        Buffer[Len++] = MinuteDigits[--NumMinuteDigits];
     }
     
-    // Set the text
-    TimerText->SetText(FText::FromString(TimeString));
+    Buffer[Len++] = TEXT(':');
+    Buffer[Len++] = TEXT('0') + (Seconds / 10);
+    Buffer[Len++] = TEXT('0') + (Seconds % 10);
     
+    if (bShowMilliseconds)
+    {
+        const int32 Hundredths = TotalHundredths % 100;
+        Buffer[Len++] = TEXT('.');
+        Buffer[Len++] = TEXT('0') + (Hundredths / 10);
+        Buffer[Len++] = TEXT('0') + (Hundredths % 10);
+    }
+    
+    TimeStringBuffer.Reset();
+    TimeStringBuffer.AppendChars(Buffer, Len);
+}
+
+void UTimerWidget::UpdateTimerColor()
+{
     // Calculate the color based on remaining time percentage
-    float TimePercentage = CurrentTime / InitialTime;
+    const float TimePercentage = InitialTime > 0.0f ? CurrentTime / InitialTime : 0.0f;
     
-    if (TimePercentage <= WarningThreshold)
+    if (TimePercentage > WarningThreshold)
     {
-        // Interpolate color from warning to normal based on time remaining
-        float Alpha = TimePercentage / WarningThreshold;
-        FLinearColor CurrentColor = FLinearColor::LerpUsingHSV(WarningColor, NormalColor, Alpha);
-        
-        // Add pulsating effect when close to zero
-        if (TimePercentage < WarningThreshold / 2.0f)
+        // Outside the warning band the color is constant, so only set it on the way out
+        if (bInWarningBand || bColorDirty)
         {
-            // Pulse frequency increases as time gets lower
-            float PulseRate = 2.0f + (1.0f - TimePercentage) * 8.0f;
-            float PulseAmount = 0.2f * (1.0f - TimePercentage) * FMath::Sin(GetWorld()->GetTimeSeconds() * PulseRate);
-            
-            // Make color pulse brighter
-            CurrentColor.R = FMath::Min(CurrentColor.R + PulseAmount, 1.0f);
-            CurrentColor.G = FMath::Min(CurrentColor.G + PulseAmount, 1.0f);
-            CurrentColor.B = FMath::Min(CurrentColor.B + PulseAmount, 1.0f);
+            bInWarningBand = false;
+            bColorDirty = false;
+            TimerText->SetColorAndOpacity(NormalColor);
         }
-        
-        TimerText->SetColorAndOpacity(CurrentColor);
+        return;
     }
-    else
+    
+    bInWarningBand = true;
+    
+    // Interpolate color from warning to normal based on time remaining
+    const float Alpha = WarningThreshold > 0.0f ? TimePercentage / WarningThreshold : 0.0f;
+    FLinearColor CurrentColor = FLinearColor::LerpUsingHSV(WarningColor, NormalColor, Alpha);
+    
+    // Add pulsating effect when close to zero
+    if (TimePercentage < WarningThreshold / 2.0f)
     {
-        // Use normal color
-        TimerText->SetColorAndOpacity(NormalColor);
+        // Pulse frequency increases as time gets lower
+        const float PulseRate = 2.0f + (1.0f - TimePercentage) * 8.0f;
+        const float PulseAmount = 0.2f * (1.0f - TimePercentage) * FMath::Sin(GetWorld()->GetTimeSeconds() * PulseRate);
+        
+        // Make color pulse brighter
+        CurrentColor.R = FMath::Min(CurrentColor.R + PulseAmount, 1.0f);
+        CurrentColor.G = FMath::Min(CurrentColor.G + PulseAmount, 1.0f);
+        CurrentColor.B = FMath::Min(CurrentColor.B + PulseAmount, 1.0f);
     }
+    
+    TimerText->SetColorAndOpacity(CurrentColor);
 }
\ No newline at end of file
@@ -8,8 +8,8 @@
 // Sets default values
 AUIContainerActor::AUIContainerActor()
 {
-    // Set this actor to call Tick() every frame
-    PrimaryActorTick.bCanEverTick = true;
+    // Widgets are driven by their own tick; the container has nothing to do per frame
+    PrimaryActorTick.bCanEverTick = false;
 
     // Create a root scene component
     RootSceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
@@ -40,12 +40,6 @@ void AUIContainerActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
     RemoveAllWidgets();
 }
 
-// Called every frame
-void AUIContainerActor::Tick(float DeltaTime)
-{
-    Super::Tick(DeltaTime);
-}
-
 // Add a widget to this container at runtime
 UUserWidget* AUIContainerActor::AddWidget(TSubclassOf<UUserWidget> WidgetClass)
 {
@@ -61,12 +55,10 @@ UUserWidget* AUIContainerActor::AddWidget(TSubclassOf<UUserWidget> WidgetClass)
         return nullptr;
     }
     
-    UUserWidget* NewWidget = CreateWidget<UUserWidget>(PlayerController, WidgetClass);
+    // Create it inside its cached HUD layer and add to viewport
+    UUserWidget* NewWidget = UHUDLayerLibrary::CreateHUDLayer(PlayerController, WidgetClass, LayerSettings);
     if (NewWidget)
     {
-        // Add to viewport
-        NewWidget->AddToViewport();
-        
         // Add to our instances array
         WidgetInstances.Add(NewWidget);
         
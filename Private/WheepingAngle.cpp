@@ -1,4 +1,5 @@
 #include "WheepingAngle.h"
+#include "FirstPersonTest.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/SceneComponent.h"
 #include "Engine/World.h"
@@ -35,6 +36,8 @@ AWheepingAngle::AWheepingAngle()
     DebugBreakDelay = 3.0f;
     
     LastTeleportTime = 0.0f;
+
+    TickSignificance.bAllowDormant = false;
 }
 
 AWheepingAngle::~AWheepingAngle() = default;
@@ -43,6 +46,11 @@ void AWheepingAngle::BeginPlay()
 {
     Super::BeginPlay();
 
+    if (UTickSignificanceSubsystem* Significance = UTickSignificanceSubsystem::Get(this))
+    {
+        Significance->RegisterActor(this, TickSignificance);
+    }
+
     if (bEnableDebugDestroy)
     {
         GetWorld()->GetTimerManager().SetTimer(
@@ -129,6 +137,9 @@ void AWheepingAngle::TeleportBehindPlayer(const FVector& PlayerLocation, const F
 
 void AWheepingAngle::BreakAngel()
 {
+    SCOPE_CYCLE_COUNTER(STAT_BreakAngel);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AWheepingAngle::BreakAngel);
+
     if (UWorld* World = GetWorld())
     {
         FVector Origin = GetActorLocation();
@@ -171,6 +182,8 @@ void AWheepingAngle::BreakAngel()
                 MeshComp->AddImpulse(Impulse, NAME_None, true);
 
                 Shard->SetLifeSpan(DestroyDelay);
+                Shard->OnEndPlay.AddDynamic(GetMutableDefault<AWheepingAngle>(), &AWheepingAngle::OnShardEndPlay);
+                INC_DWORD_STAT(STAT_LiveShards);
 
                 DrawDebugSphere(World, SpawnLocation, 15.f, 12, FColor::Red, false, 2.f);
             }
@@ -182,6 +195,11 @@ void AWheepingAngle::BreakAngel()
     }
 }
 
+void AWheepingAngle::OnShardEndPlay(AActor* Shard, EEndPlayReason::Type EndPlayReason)
+{
+    DEC_DWORD_STAT(STAT_LiveShards);
+}
+
 void AWheepingAngle::DestroyAngel()
 {
     SetLifeSpan(DestroyDelay);
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera/CameraModifier.h"
+#include "CameraSwayModifier.generated.h"
+
+class UCameraSwayProfile;
+
+// Head bob, breathing, strafe sway and landing dip for AMyFPSCharacter, applied as an offset to the
+// final view instead of moving the camera component, so nothing attached to the camera (hold point,
+// held item) has its transform updated every frame. Tuning comes from the idle, walk and sprint
+// UCameraSwayProfile assets on the character being viewed, crossfaded by movement state.
+UCLASS()
+class FIRSTPERSONTEST_API UCameraSwayModifier : public UCameraModifier
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ModifyCamera(float DeltaTime, struct FMinimalViewInfo& InOutPOV) override;
+
+private:
+    enum { IdleProfile, WalkProfile, SprintProfile, NumProfiles };
+
+    // Built-in sprint profile derived from the walk profile it was created from
+    const UCameraSwayProfile* GetDefaultSprintProfile(const UCameraSwayProfile* Walk);
+
+    UPROPERTY(Transient)
+    UCameraSwayProfile* DefaultSprintProfile = nullptr;
+
+    TWeakObjectPtr<const UCameraSwayProfile> DefaultSprintSource;
+
+    FRotator CurrentRotationalSway = FRotator::ZeroRotator;
+    FVector CurrentPositionalSway = FVector::ZeroVector;
+
+    // Cycles in [0, 1)
+    float BobPhase = 0.0f;
+    float BreathingPhase = 0.0f;
+
+    float ProfileWeights[NumProfiles] = { 1.0f, 0.0f, 0.0f };
+    float LastZVelocity = 0.0f;
+    bool bWasInAir = false;
+};
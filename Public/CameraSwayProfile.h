@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CameraSwayProfile.generated.h"
+
+class UCurveFloat;
+
+enum class ECameraSwayChannel : uint8
+{
+    BobLateral,
+    BobVertical,
+    BreathingPitch,
+    BreathingHeight,
+    Num
+};
+
+// Designer-facing camera sway preset. Each curve describes one cycle of motion over X in [0, 1]
+// and is baked into a fixed-size table when the asset loads, so the camera only does table fetches
+// at runtime. A missing curve bakes the sine shape the sway used before it was data driven.
+UCLASS(BlueprintType)
+class FIRSTPERSONTEST_API UCameraSwayProfile : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr int32 TableSize = 64;
+
+    // The lean and bob boost sprinting had before it was data driven
+    static constexpr float DefaultSprintPitchOffset = -2.0f;
+    static constexpr float DefaultSprintBobScale = 1.5f;
+
+    virtual void PostInitProperties() override;
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    // Phase is in cycles; only its fractional part is used
+    float Sample(ECameraSwayChannel Channel, float Phase) const;
+
+    // Transient copy of this profile with the built-in sprint lean and bob boost, for characters without a sprint profile
+    UCameraSwayProfile* CreateDefaultSprintProfile(UObject* Outer) const;
+
+    // Side-to-side head bob over one step cycle, scaled by BobAmount
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bob")
+    UCurveFloat* BobLateralCurve = nullptr;
+
+    // Vertical head bob over one step cycle, scaled by BobAmount
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bob")
+    UCurveFloat* BobVerticalCurve = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bob")
+    float BobAmount = 10.0f;
+
+    // Step cycles per second when moving at BobReferenceSpeed; scales linearly with speed
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bob", meta = (ClampMin = "0.0"))
+    float BobFrequency = 0.8f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bob", meta = (ClampMin = "1.0"))
+    float BobReferenceSpeed = 500.0f;
+
+    // Pitch over one breath, scaled by BreathingAmount
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breathing")
+    UCurveFloat* BreathingPitchCurve = nullptr;
+
+    // Height over one breath, scaled by BreathingAmount
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breathing")
+    UCurveFloat* BreathingHeightCurve = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breathing")
+    float BreathingAmount = 0.3f;
+
+    // Breaths per second
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Breathing", meta = (ClampMin = "0.0"))
+    float BreathingRate = 0.16f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sway")
+    float RotationalSwayAmount = 3.0f;
+
+    // Constant pitch added while this profile is active, e.g. leaning into a sprint
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sway")
+    float PitchOffset = 0.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sway")
+    float SwaySpeed = 2.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sway")
+    float ReturnSpeed = 5.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sway")
+    float LandingBobAmount = 10.0f;
+
+private:
+    void BakeTables();
+
+    float Tables[(int32)ECameraSwayChannel::Num][TableSize];
+};
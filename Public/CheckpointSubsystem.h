@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "CheckpointSubsystem.generated.h"
+
+class APickableItem;
+class AOxygenReplenishActor;
+
+struct FPuzzleCheckpoint
+{
+    float CompletionPercentage = 0.0f;
+    bool bIsCompleted = false;
+    bool bIsActive = false;
+    float MachineProgress = 0.0f;
+    bool bMachineFixed = false;
+};
+
+struct FItemCheckpoint
+{
+    TWeakObjectPtr<APickableItem> Item;
+    FTransform Transform;
+};
+
+struct FReplenishCheckpoint
+{
+    TWeakObjectPtr<AOxygenReplenishActor> Actor;
+    bool bConsumed = false;
+};
+
+// Only the state that changes during play; everything else stays as the level loaded it
+struct FCheckpointSnapshot
+{
+    bool bValid = false;
+
+    // Identifies which actors the entry indices refer to, so saves from another layout are rejected
+    uint32 LayoutHash = 0;
+
+    FTransform PlayerTransform;
+    FRotator ControlRotation;
+    float Oxygen = 0.0f;
+
+    int32 CurrentPuzzleIndex = 0;
+    TArray<FPuzzleCheckpoint> Puzzles;
+    TArray<FItemCheckpoint> Items;
+    TArray<FReplenishCheckpoint> ReplenishActors;
+};
+
+// Captures restorable gameplay state and puts it back in place, so a death restart
+// does not reload the map. A checkpoint is taken on the first tick of play and whenever a puzzle is solved.
+UCLASS(Config = Game)
+class FIRSTPERSONTEST_API UCheckpointSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    static UCheckpointSubsystem* Get(const UObject* WorldContextObject);
+
+    UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+    void CaptureCheckpoint();
+
+    // Returns false if there is no checkpoint to restore
+    UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+    bool RestoreCheckpoint();
+
+    UFUNCTION(BlueprintPure, Category = "Checkpoint")
+    bool HasCheckpoint() const { return Checkpoint.bValid; }
+
+    // Encodes the current state against the level defaults and writes it on a worker thread
+    UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+    void SaveToSlot(const FString& SlotName);
+
+    // Reads a slot written by SaveToSlot, makes it the current checkpoint and restores it
+    UFUNCTION(BlueprintCallable, Category = "Checkpoint")
+    bool LoadFromSlot(const FString& SlotName);
+
+    const FCheckpointSnapshot& GetCheckpoint() const { return Checkpoint; }
+    const FCheckpointSnapshot& GetLevelDefaults() const { return LevelDefaults; }
+
+    static FString GetSlotPath(const FString& SlotName);
+
+protected:
+    // Write the autosave slot every time a checkpoint is captured during play
+    UPROPERTY(Config)
+    bool bAutosaveOnCheckpoint = true;
+
+    UPROPERTY(Config)
+    FString AutosaveSlotName = TEXT("Autosave");
+
+    // A restore never hands back less than this fraction of the oxygen the level started with, so a
+    // checkpoint taken while nearly out of air cannot trap the player in a death loop. 1 gives full
+    // level-start oxygen on every restore, as the old map reload did.
+    UPROPERTY(Config)
+    float MinRestoredOxygenFraction = 1.0f;
+
+private:
+    void CaptureLevelDefaults();
+    void CaptureSnapshot(FCheckpointSnapshot& OutSnapshot) const;
+    void WriteSnapshotAsync(FCheckpointSnapshot State, const FString& SlotName);
+
+    // Arrays are reset rather than reallocated between captures
+    FCheckpointSnapshot Checkpoint;
+
+    // State as the level began play; saves only store what differs from it
+    FCheckpointSnapshot LevelDefaults;
+
+    int32 SaveSerial = 0;
+
+    // Last queued write; each save waits on the one before it, so slots are written in request order
+    FGraphEventRef LastSaveTask;
+};
@@ -8,16 +8,22 @@
 #include "Components/TextBlock.h"
 #include "Engine/LevelScriptActor.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/DataTable.h"
+#include "Engine/StreamableManager.h"
 #include "DialoguePlayer.generated.h"
 
-// Struct to hold individual dialogue entry data
+// Struct to hold individual dialogue entry data (also used as a data table row)
 USTRUCT(BlueprintType)
-struct FDialogueEntry
+struct FDialogueEntry : public FTableRowBase
 {
     GENERATED_BODY()
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     FString Text;
+
+    // Shown instead of Text when set; can reference a string table entry for localization
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+    FText LocalizedText;
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     FLinearColor TextColor = FLinearColor(1.0f, 1.0f, 1.0f, 1.0f);
@@ -27,6 +33,8 @@ struct FDialogueEntry
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     float DelayAfter = 1.0f;
+
+    FText GetDisplayText() const { return LocalizedText.IsEmpty() ? FText::FromString(Text) : LocalizedText; }
 };
 
 UCLASS()
@@ -39,11 +47,13 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
 private:
     FString CurrentText;
     FString TargetText;
+    FText TargetDisplayText;
     float TypewriterDelay;
     float CurrentDelay;
     int32 CurrentCharIndex;
@@ -52,6 +62,11 @@ private:
     FLinearColor CurrentTextColor;
     bool bAllowInput;
     
+    // Keeps the dialogue table resident while this player is using it
+    TSharedPtr<FStreamableHandle> DialogueTableHandle;
+    
+    void OnDialogueTableLoaded();
+    
 public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     TSubclassOf<UUserWidget> DialogueWidgetClass;
@@ -59,6 +74,11 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     TArray<FDialogueEntry> DialogueEntries;
     
+    // Optional script table (FDialogueEntry rows), loaded asynchronously and played in row order.
+    // When set, its rows replace DialogueEntries.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue", meta = (RequiredAssetDataTags = "RowStructure=/Script/FirstPersonTest.DialogueEntry"))
+    TSoftObjectPtr<UDataTable> DialogueTable;
+    
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     float IntroDelay = 1.0f;
     
@@ -83,8 +103,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Dialogue")
     void SkipTypewriter();
     
+    // Kept with its original FString signature so existing Blueprint call sites still compile
     UFUNCTION(BlueprintCallable, Category = "Dialogue")
     void SetDialogueText(const FString& NewText, const FLinearColor& TextColor, float Speed);
+
+    // Preferred for localized lines, e.g. entries that reference a string table
+    UFUNCTION(BlueprintCallable, Category = "Dialogue")
+    void SetDialogueTextFromText(const FText& NewText, const FLinearColor& TextColor, float Speed);
     
     UFUNCTION()
     void OnTypewriterComplete();
@@ -3,10 +3,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Components/BoxComponent.h"
+#include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Blueprint/UserWidget.h"
 #include "Components/TextBlock.h"
 #include "GameFramework/Character.h"
+#include "Engine/StreamableManager.h"
+#include "DialoguePlayer.h"
+#include "TickSignificanceSubsystem.h"
 #include "DialogueTrigger.generated.h"
 
 UENUM(BlueprintType)
@@ -29,6 +33,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
 public:
@@ -38,12 +43,31 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UStaticMeshComponent* MeshComponent;
 
+    // Entering this volume starts streaming DialogueTable, so it is resident before TriggerBox is reached
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
+    USphereComponent* PreloadSphere;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     FString DialogueText = TEXT("Hello, welcome to the station!");
 
+    // Shown instead of DialogueText when set; can reference a string table entry for localization
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+    FText LocalizedDialogueText;
+
+    // Optional script table; when set, DialogueRowName is loaded from it instead of using the text above
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue", meta = (RequiredAssetDataTags = "RowStructure=/Script/FirstPersonTest.DialogueEntry"))
+    TSoftObjectPtr<UDataTable> DialogueTable;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
+    FName DialogueRowName;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     float TypewriterSpeed = 0.05f;
 
+    // Applies while no dialogue is playing; playback always ticks every frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    FTickSignificanceSettings TickSignificance;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
     float FadeInDuration = 0.5f;
 
@@ -95,6 +119,12 @@ public:
     UFUNCTION()
     void OnTriggerEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
+    UFUNCTION()
+    void OnPreloadBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+    UFUNCTION()
+    void OnPreloadEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
     UFUNCTION(BlueprintCallable, Category = "Dialogue")
     void StartDialogue();
 
@@ -104,7 +134,26 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Dialogue")
     void ResetDialogue();
 
+    UFUNCTION(BlueprintCallable, Category = "Dialogue")
+    void PreloadDialogue();
+
+    UFUNCTION(BlueprintCallable, Category = "Dialogue")
+    void ReleaseDialogue();
+
 private:
     void UpdateDialogue(float DeltaTime);
     void SetDialogueWidgetOpacity(float Opacity);
+    void OnDialogueTableLoaded();
+
+    // Line from DialogueTable, once loaded
+    FText TableText;
+    bool bHasTableText = false;
+
+    // Text being shown, and its display string resolved once per playback
+    FText DisplayText;
+    FString ResolvedText;
+
+    TSharedPtr<FStreamableHandle> DialogueTableHandle;
+    bool bDialogueLoaded = false;
+    bool bStartWhenLoaded = false;
 };
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "GameFramework/Character.h"
 #include "IInteractable.h"
 #include "PuzzleManager.h"
+#include "TickSignificanceSubsystem.h"
 #include "GameConditionManager.generated.h"
 
 UCLASS()
@@ -36,6 +37,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Game Condition")
     bool bRequireAllPuzzlesSolved = true;
 
+    // Distance-based tick throttling, see UTickSignificanceSubsystem
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    FTickSignificanceSettings TickSignificance;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Game Condition")
     APuzzleManager* PuzzleManagerRef;
 
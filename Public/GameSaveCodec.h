@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CheckpointSubsystem.h"
+
+// Binary save format for FCheckpointSnapshot. Only entries that differ from the level
+// defaults (the snapshot taken when the level began play) are written, so an untouched
+// level saves to little more than the header and player state.
+//
+// Layout (version 1):
+//   uint32 Magic, uint16 Version, uint32 LayoutHash
+//   player transform, control rotation, oxygen, current puzzle index
+//   changed puzzles   : packed count, then (packed index, flags, completion, machine progress)
+//   moved items       : packed count, then (packed index, location, rotation)
+//   replenish actors  : packed count, then (packed index) for each entry whose consumed flag flipped
+struct FIRSTPERSONTEST_API FGameSaveCodec
+{
+    static constexpr uint32 Magic = 0x56535046; // "FPSV"
+    static constexpr uint16 CurrentVersion = 1;
+
+    // Whether State has exactly the puzzles, items and replenish actors Defaults has; entries are matched by index
+    static bool MatchesLayout(const FCheckpointSnapshot& State, const FCheckpointSnapshot& Defaults);
+
+    // Thread-safe: reads only plain values from the snapshots, never the actor pointers.
+    // Fails, leaving OutBytes empty, if State does not match the layout of Defaults.
+    static bool Encode(const FCheckpointSnapshot& State, const FCheckpointSnapshot& Defaults, TArray<uint8>& OutBytes);
+
+    // Rebuilds a snapshot from Defaults plus the saved deltas. Fails on foreign data, newer
+    // versions, or a save taken against a different level layout.
+    static bool Decode(const TArray<uint8>& Bytes, const FCheckpointSnapshot& Defaults, FCheckpointSnapshot& OutState);
+};
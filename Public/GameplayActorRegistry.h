@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayActorRegistry.generated.h"
+
+// Per-world lookup for singleton-style gameplay actors (managers, oxygen system, ...).
+// Managers register themselves in BeginPlay and unregister in EndPlay; dependents
+// resolve them by class instead of scanning every actor in the level.
+UCLASS()
+class FIRSTPERSONTEST_API UGameplayActorRegistry : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    static UGameplayActorRegistry* Get(const UObject* WorldContextObject);
+
+    void RegisterActor(UClass* Key, AActor* Actor);
+    void UnregisterActor(UClass* Key, AActor* Actor);
+    AActor* FindActor(UClass* Key) const;
+
+    // Appends every live actor registered under Key
+    void GetActors(UClass* Key, TArray<AActor*>& OutActors) const;
+
+    // Calls Callback with the first actor registered under Key, right away if one already
+    // exists, otherwise once it registers. The callback is dropped if Listener is destroyed first.
+    void WhenRegistered(UClass* Key, const UObject* Listener, TFunction<void(AActor*)> Callback);
+
+    template<typename T>
+    void Register(T* Actor) { RegisterActor(T::StaticClass(), Actor); }
+
+    template<typename T>
+    void Unregister(T* Actor) { UnregisterActor(T::StaticClass(), Actor); }
+
+    template<typename T>
+    T* Find() const { return Cast<T>(FindActor(T::StaticClass())); }
+
+    template<typename T>
+    void ForEach(TFunctionRef<void(T*)> Callback) const
+    {
+        if (const TArray<TWeakObjectPtr<AActor>>* Actors = ActorsByClass.Find(T::StaticClass()))
+        {
+            for (const TWeakObjectPtr<AActor>& Entry : *Actors)
+            {
+                if (T* Actor = Cast<T>(Entry.Get()))
+                {
+                    Callback(Actor);
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    void WhenRegistered(const UObject* Listener, TFunction<void(T*)> Callback)
+    {
+        WhenRegistered(T::StaticClass(), Listener, [Callback = MoveTemp(Callback)](AActor* Actor)
+        {
+            Callback(CastChecked<T>(Actor));
+        });
+    }
+
+private:
+    struct FPendingListener
+    {
+        TWeakObjectPtr<const UObject> Listener;
+        TFunction<void(AActor*)> Callback;
+    };
+
+    TMap<UClass*, TArray<TWeakObjectPtr<AActor>>> ActorsByClass;
+    TMap<UClass*, TArray<FPendingListener>> PendingListeners;
+};
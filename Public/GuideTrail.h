@@ -7,6 +7,7 @@
 #include "Components/SplineComponent.h"
 #include "Components/SplineMeshComponent.h"
 #include "NiagaraComponent.h"
+#include "TickSignificanceSubsystem.h"
 #include "GuideTrail.generated.h"
 
 UCLASS()
@@ -42,6 +43,10 @@ public:
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Trail")
     bool bAutoActivate = true;
+
+    // Applies while the trail is inactive; an active trail always ticks every frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    FTickSignificanceSettings TickSignificance;
     
     UFUNCTION(BlueprintCallable, Category = "Trail")
     void ActivateTrail();
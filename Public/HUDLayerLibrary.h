@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Blueprint/UserWidget.h"
+#include "HUDLayerLibrary.generated.h"
+
+class APlayerController;
+
+UENUM(BlueprintType)
+enum class EHUDLayerCaching : uint8
+{
+    None            UMETA(DisplayName = "None"),
+    Invalidation    UMETA(DisplayName = "Invalidation Box"),
+    Retainer        UMETA(DisplayName = "Retainer Box")
+};
+
+// How a HUD widget is composited into the viewport
+USTRUCT(BlueprintType)
+struct FHUDLayerSettings
+{
+    GENERATED_BODY()
+
+    // Invalidation caches the layer's paint until a child changes; Retainer renders it to a texture on a fixed phase
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HUD Layer")
+    EHUDLayerCaching Caching = EHUDLayerCaching::Invalidation;
+
+    // Retainer only: the layer is redrawn once every N frames (call RequestHUDLayerRedraw for an immediate update)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HUD Layer", meta = (ClampMin = "1", ClampMax = "60", EditCondition = "Caching == EHUDLayerCaching::Retainer"))
+    int32 RedrawEveryNFrames = 4;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HUD Layer")
+    int32 ZOrder = 0;
+};
+
+UCLASS()
+class FIRSTPERSONTEST_API UHUDLayerLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    // Creates the widget, wraps its root in the cache box requested by Settings and adds it to the viewport
+    UFUNCTION(BlueprintCallable, Category = "UI|HUD Layer")
+    static UUserWidget* CreateHUDLayer(APlayerController* OwningPlayer, TSubclassOf<UUserWidget> WidgetClass, const FHUDLayerSettings& Settings);
+
+    // Forces a cached layer to repaint on the next frame
+    UFUNCTION(BlueprintCallable, Category = "UI|HUD Layer")
+    static void RequestHUDLayerRedraw(UUserWidget* Layer);
+
+private:
+    static void WrapRootWidget(UUserWidget* Widget, const FHUDLayerSettings& Settings);
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "HUDWidgetRegistry.generated.h"
+
+class APlayerController;
+
+// Tracks the HUD widgets owned by a local player, one per widget class.
+// The local player outlives the level, so widgets are released when their world is cleaned up.
+UCLASS()
+class FIRSTPERSONTEST_API UHUDWidgetRegistry : public ULocalPlayerSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    static UHUDWidgetRegistry* Get(const APlayerController* PlayerController);
+
+    // Registers Widget as the instance of its class, releasing any previous instance
+    UFUNCTION(BlueprintCallable, Category = "UI|HUD Registry")
+    void RegisterWidget(UUserWidget* Widget);
+
+    UFUNCTION(BlueprintCallable, Category = "UI|HUD Registry")
+    void UnregisterWidget(UUserWidget* Widget);
+
+    UFUNCTION(BlueprintPure, Category = "UI|HUD Registry")
+    UUserWidget* FindWidget(TSubclassOf<UUserWidget> WidgetClass) const;
+
+    // Removes the registered widget of this class from the viewport and forgets it
+    UFUNCTION(BlueprintCallable, Category = "UI|HUD Registry")
+    void ReleaseWidget(TSubclassOf<UUserWidget> WidgetClass);
+
+private:
+    void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+    UPROPERTY()
+    TMap<UClass*, UUserWidget*> WidgetsByClass;
+
+    FDelegateHandle WorldCleanupHandle;
+};
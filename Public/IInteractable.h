@@ -35,4 +35,12 @@ public:
 	// Get the interaction prompt text
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Interaction")
 	FText GetInteractionText() const;
+
+	// Hold interactions (native only). If SupportsHold returns true, the interact manager calls
+	// BeginHold instead of Interact when the key goes down, TickHold every frame it stays down,
+	// and EndHold on release or when focus moves away.
+	virtual bool SupportsHold() const { return false; }
+	virtual void BeginHold(AActor* Interactor) {}
+	virtual void TickHold(AActor* Interactor, float DeltaTime) {}
+	virtual void EndHold(AActor* Interactor) {}
 };
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ImpactAudioSubsystem.generated.h"
+
+class UAudioComponent;
+class UPrimitiveComponent;
+class USoundBase;
+class USoundConcurrency;
+
+// Collects physics impact sounds over a frame and plays only the strongest few through a fixed
+// pool of audio components, so a collapsing pile costs a bounded number of voices and never
+// spawns one-shot components. It also switches rigid-body hit notifications off for registered
+// sound sources that are too far from the listener to be heard, so the physics engine stops
+// generating hit events nobody will play.
+UCLASS(Config = Game)
+class FIRSTPERSONTEST_API UImpactAudioSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    static UImpactAudioSubsystem* Get(const UObject* WorldContextObject);
+
+    // Impulse ranks the hit against the rest of the frame's hits; a source only keeps its strongest hit per frame
+    void QueueImpact(USoundBase* Sound, const FVector& Location, float Impulse, float VolumeMultiplier, const AActor* Source);
+
+    // Hit notifications on Component follow the listener distance from now on; a CullDistance of 0 keeps them always on
+    void RegisterHitSource(UPrimitiveComponent* Component, float CullDistance);
+    // Leaves hit notifications off, since only registered sources need them
+    void UnregisterHitSource(UPrimitiveComponent* Component);
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override { return Pending.Num() > 0 || HitSources.Num() > 0; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+    UPROPERTY(Config)
+    int32 MaxImpactsPerFrame = 4;
+
+    // Upper bound on impact voices; when every component is busy the longest-playing one is reused
+    UPROPERTY(Config)
+    int32 PoolSize = 8;
+
+    // Optional concurrency applied to every pooled component, e.g. to cap impacts per sound
+    UPROPERTY(Config)
+    TSoftObjectPtr<USoundConcurrency> ImpactConcurrency;
+
+    UPROPERTY(Config)
+    int32 HitSourcesEvaluatedPerFrame = 32;
+
+    // Fraction the cull distance must be exceeded by before hit notifications are switched off
+    UPROPERTY(Config)
+    float HitNotifyHysteresis = 0.1f;
+
+private:
+    struct FPendingImpact
+    {
+        USoundBase* Sound = nullptr;
+        FVector Location = FVector::ZeroVector;
+        float Impulse = 0.0f;
+        float VolumeMultiplier = 1.0f;
+        const AActor* Source = nullptr;
+    };
+
+    struct FHitSource
+    {
+        const UPrimitiveComponent* Key = nullptr;
+        TWeakObjectPtr<UPrimitiveComponent> Component;
+        float CullDistanceSquared = 0.0f;
+        bool bNotifying = false;
+    };
+
+    void UpdateHitSources(const FVector& ListenerLocation);
+    void SetNotifying(FHitSource& Source, bool bNotify);
+    void RemoveHitSourceAt(int32 Index);
+
+    UAudioComponent* AcquireComponent();
+    UAudioComponent* CreatePooledComponent();
+
+    // Kept to the MaxImpactsPerFrame strongest hits as they arrive
+    TArray<FPendingImpact> Pending;
+
+    UPROPERTY()
+    TArray<UAudioComponent*> Pool;
+
+    TArray<double> PoolStartTimes;
+
+    TArray<FHitSource> HitSources;
+    TMap<const UPrimitiveComponent*, int32> HitSourceIndex;
+    int32 NextHitSourceToEvaluate = 0;
+
+    UPROPERTY()
+    USoundConcurrency* Concurrency = nullptr;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputReplayComponent.generated.h"
+
+class AMyFPSCharacter;
+
+// Action inputs the character binds; stored as bits in FRecordedInputFrame
+enum class EReplayInputAction : uint8
+{
+    None        = 0,
+    Jump        = 1 << 0,
+    Sprint      = 1 << 1,
+    Interact    = 1 << 2,
+    PhysicsGrab = 1 << 3,
+    Throw       = 1 << 4,
+};
+ENUM_CLASS_FLAGS(EReplayInputAction);
+
+DECLARE_DELEGATE_OneParam(FReplayInputActionDelegate, EReplayInputAction);
+
+// Everything the character's input bindings received during one frame
+struct FRecordedInputFrame
+{
+    float MoveForward = 0.0f;
+    float MoveRight = 0.0f;
+    float Turn = 0.0f;
+    float LookUp = 0.0f;
+
+    // Actions pressed and released this frame; presses are applied before releases
+    EReplayInputAction Pressed = EReplayInputAction::None;
+    EReplayInputAction Released = EReplayInputAction::None;
+};
+
+// Records the owning character's bound inputs to Saved/InputReplays/<Name>.fpinput and plays them
+// back on a fixed timestep, so the same session can be re-run headless for comparable captures.
+// Ticks ahead of the player controller so replayed input lands in the same frame slot as live input.
+//
+// Layout (version 1):
+//   uint32 Magic, uint16 Version, float FixedDeltaTime, start location, start control rotation
+//   packed frame count, then per frame a change mask followed by only the fields that changed
+//
+// Console: FirstPersonTest.RecordInput [Name], FirstPersonTest.ReplayInput [Name]
+// Command line: -RecordInput=Name, -ReplayInput=Name
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class FIRSTPERSONTEST_API UInputReplayComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UInputReplayComponent();
+
+    static constexpr uint32 Magic = 0x52495046; // "FPIR"
+    static constexpr uint16 CurrentVersion = 1;
+
+    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+    UFUNCTION(BlueprintCallable, Category = "Input Replay")
+    bool StartRecording(const FString& Name);
+
+    // Writes the recording to disk
+    UFUNCTION(BlueprintCallable, Category = "Input Replay")
+    void StopRecording();
+
+    UFUNCTION(BlueprintCallable, Category = "Input Replay")
+    bool StartReplay(const FString& Name);
+
+    UFUNCTION(BlueprintCallable, Category = "Input Replay")
+    void StopReplay();
+
+    bool IsRecording() const { return bRecording; }
+    bool IsReplaying() const { return bReplaying; }
+
+    static FString GetReplayPath(const FString& Name);
+
+    // Broadcast when a replay runs out of frames or is stopped
+    FSimpleMulticastDelegate OnReplayFinished;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Timestep used while recording; a replay always uses the one stored in its file
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input Replay", meta = (ClampMin = "0.001"))
+    float FixedDeltaTime = 1.0f / 60.0f;
+
+private:
+    AMyFPSCharacter* GetCharacter() const;
+    void StartFromCommandLine();
+    // bRealTime also holds the frame rate to 1 / DeltaTime, so a recording plays out at the speed the player sees
+    void Begin(float DeltaTime, bool bRealTime);
+    void End();
+
+    static void SerializeFrame(FArchive& Ar, FRecordedInputFrame& Frame, const FRecordedInputFrame& Previous);
+
+    TArray<FRecordedInputFrame> Frames;
+    int32 NextReplayFrame = 0;
+    FString ActiveName;
+
+    FVector StartLocation = FVector::ZeroVector;
+    FRotator StartRotation = FRotator::ZeroRotator;
+    float RecordedDeltaTime = 0.0f;
+
+    bool bRecording = false;
+    bool bReplaying = false;
+
+    TWeakObjectPtr<AController> DependentController;
+    bool bPreviousUseFixedTimeStep = false;
+    double PreviousFixedDeltaTime = 0.0;
+    bool bOwnsFixedFrameRate = false;
+    bool bPreviousUseFixedFrameRate = false;
+    float PreviousFixedFrameRate = 0.0f;
+};
@@ -5,6 +5,15 @@
 #include "IInteractable.h"
 #include "InteractManager.generated.h"
 
+UENUM(BlueprintType)
+enum class EInteractionFocusMode : uint8
+{
+	// Focus whatever the view ray hits
+	LineTrace,
+	// Focus the best-scoring interactable in a cone around the view direction, confirmed by one trace
+	Proximity
+};
+
 UCLASS()
 class FIRSTPERSONTEST_API AInteractManager : public AActor
 {
@@ -36,12 +45,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Interaction")
 	void StopInteract();
 
+	// Focus traces issued since BeginPlay
+	int32 GetTraceCount() const { return TraceCount; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
 	float InteractionRange = 500.0f;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
+	EInteractionFocusMode FocusMode = EInteractionFocusMode::LineTrace;
+
+	// How far off the view direction an interactable's bounds may be and still take focus in Proximity mode
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction", meta = (ClampMin = "0.0", ClampMax = "45.0", EditCondition = "FocusMode == EInteractionFocusMode::Proximity"))
+	float FocusConeHalfAngle = 10.0f;
+
+	// Most confirming traces per frame in Proximity mode when the best candidates turn out to be hidden
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction", meta = (ClampMin = "1", EditCondition = "FocusMode == EInteractionFocusMode::Proximity"))
+	int32 MaxFocusTraces = 3;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
 	bool bShowDebugRaycast = false;
 
@@ -63,6 +87,22 @@ protected:
 	UPROPERTY()
 	bool bIsInteracting = false;
 
+	int32 TraceCount = 0;
+
+	// Native hold protocol of CurrentInteractable, cached on focus change (null if it has none)
+	IInteractable* FocusedHoldTarget = nullptr;
+
+	// Target currently being held; the weak object guards against it being destroyed mid-hold
+	IInteractable* ActiveHoldTarget = nullptr;
+	TWeakObjectPtr<UObject> ActiveHoldObject;
+
+	void SetFocus(const TScriptInterface<IInteractable>& NewInteractable);
+	void BeginActiveHold();
+	void EndActiveHold();
+
 	void PerformInteractionRaycast();
+
+	// Line trace that returns the hit actor if it is interactable; bOutBlocked is set if anything was hit
+	AActor* TraceForInteractable(const FVector& Start, const FVector& End, bool& bOutBlocked);
 	void UpdatePromptVisibility(bool bVisible, const FText& Text = FText::GetEmpty());
 };
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Calls into IInteractable without going through the Blueprint event thunks when they are not needed.
+// The first call for a class records whether it implements the interface, where the native interface
+// lives inside the object, and which events are still native (not overridden in Blueprint). Later
+// calls on that class are a map lookup plus a direct virtual call to the _Implementation.
+// Game thread only.
+struct FIRSTPERSONTEST_API FInteractableDispatch
+{
+    // Cached ImplementsInterface(UInteractable)
+    static bool Implements(const UClass* Class);
+
+    static bool CanInteract(UObject* Object);
+    static FText GetInteractionText(UObject* Object);
+    static void OnHighlight(UObject* Object);
+    static void OnUnhighlight(UObject* Object);
+    static void Interact(UObject* Object, AActor* Interactor);
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InteractableIndexSubsystem.generated.h"
+
+struct FInteractableCandidate
+{
+    AActor* Actor = nullptr;
+
+    // Bounds centre at the last index update; the point a confirming trace should aim for
+    FVector Center = FVector::ZeroVector;
+
+    // Higher is better: facing the view direction outweighs being close
+    float Score = 0.0f;
+};
+
+// Uniform grid of every actor that implements IInteractable. Actors are picked up when they
+// spawn or their level streams in, re-bucketed when their root component moves and dropped
+// at EndPlay, so focus can be resolved by a cone query instead of sweeping the scene.
+UCLASS(Config = Game)
+class FIRSTPERSONTEST_API UInteractableIndexSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    static UInteractableIndexSubsystem* Get(const UObject* WorldContextObject);
+
+    void RegisterActor(AActor* Actor);
+    void UnregisterActor(AActor* Actor);
+
+    // Interactables whose bounds fall within Range of Origin and within HalfAngleDegrees of
+    // Direction (widened by their bounds radius), best score first
+    void QueryCone(const FVector& Origin, const FVector& Direction, float Range, float HalfAngleDegrees, TArray<FInteractableCandidate>& OutCandidates) const;
+
+    int32 GetNumIndexed() const { return Entries.Num(); }
+
+protected:
+    UPROPERTY(Config)
+    float CellSize = 500.0f;
+
+    // How much a candidate's angle to the view direction counts against distance when scoring
+    UPROPERTY(Config)
+    float AngleWeight = 2.0f;
+
+private:
+    struct FEntry
+    {
+        const AActor* Key = nullptr;
+        TWeakObjectPtr<AActor> Actor;
+        FVector Center = FVector::ZeroVector;
+        float Radius = 0.0f;
+        FIntVector Cell = FIntVector::ZeroValue;
+        TWeakObjectPtr<USceneComponent> Root;
+        FDelegateHandle MovedHandle;
+    };
+
+    FIntVector GetCell(const FVector& Location) const;
+    void UpdateEntry(FEntry& Entry);
+    void RemoveAt(int32 Index);
+
+    void OnActorSpawned(AActor* Actor);
+    void OnLevelAdded(ULevel* Level, UWorld* World);
+    void OnRootMoved(USceneComponent* Root, EUpdateTransformFlags Flags, ETeleportType Teleport);
+
+    UFUNCTION()
+    void OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+    TArray<FEntry> Entries;
+    TMap<const AActor*, int32> IndexByActor;
+    TMap<FIntVector, TArray<const AActor*>> Cells;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle LevelAddedHandle;
+};
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "InteractionBenchmarkSubsystem.generated.h"
+
+class APickableItem;
+class AP_FixableMachine;
+class AOxygenReplenishActor;
+class AWheepingAngle;
+class ADialogueTrigger;
+
+// Frame time and tick limits one map must stay within during the benchmark
+USTRUCT()
+struct FMapPerformanceBudget
+{
+    GENERATED_BODY()
+
+    // Short map name, e.g. "Level_01"
+    UPROPERTY()
+    FString MapName;
+
+    UPROPERTY()
+    float MedianFrameMs = 8.0f;
+
+    UPROPERTY()
+    float P95FrameMs = 12.0f;
+
+    UPROPERTY()
+    float P99FrameMs = 16.0f;
+
+    // Highest number of benchmark actors allowed to tick in any one frame
+    UPROPERTY()
+    int32 MaxTickingActors = 128;
+};
+
+// Outcome of one run, kept after the run for callers such as the automation tests
+struct FInteractionBenchmarkResult
+{
+    FString MapName;
+    int32 Frames = 0;
+    float MedianMs = 0.0f;
+    float P95Ms = 0.0f;
+    float P99Ms = 0.0f;
+    int32 MaxTickingActors = 0;
+    int32 SpawnedActors = 0;
+    FMapPerformanceBudget Budget;
+    bool bWithinBudget = true;
+};
+
+// Repeatable load test for the interaction stack. Spawns a configurable population of gameplay
+// actors around the player from a fixed seed, flies the player along a scripted orbit on a fixed
+// timestep and records one CSV row per frame (game thread time, ticking actors, interaction traces,
+// tick significance buckets) to Saved/Profiling/InteractionBenchmark. If InputReplayName is set,
+// the recorded input session drives the player instead of the orbit and the run ends with it.
+//
+// At the end of a run the results are checked against the map's FMapPerformanceBudget and a row
+// is appended to BudgetReport.csv in the same folder.
+//
+// Headless:  <Project> <Map> -game -nullrhi -unattended -InteractionBenchmark   (exits when done)
+// Map sweep: <Project> -game -nullrhi -unattended -InteractionBenchmarkMaps=Level_01+Level_02
+//            (runs each map in turn; exit code 1 if any map went over budget)
+// In game:   FirstPersonTest.InteractionBenchmark
+UCLASS(Config = Game)
+class FIRSTPERSONTEST_API UInteractionBenchmarkSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    static UInteractionBenchmarkSubsystem* Get(const UObject* WorldContextObject);
+
+    void StartBenchmark(bool bQuitWhenDone);
+    void StopBenchmark();
+    bool IsRunning() const { return bRunning; }
+
+    bool HasResult() const { return bHasResult; }
+    const FInteractionBenchmarkResult& GetLastResult() const { return LastResult; }
+
+    // Actors a run spawns when every configured class loads
+    int32 GetConfiguredPopulation() const;
+
+    // Maps with an explicit budget (plus DefaultBudget's map, if it names one)
+    TArray<FString> GetBudgetedMaps() const;
+
+    // Percentiles of FrameTimes checked against Budget; MapName and SpawnedActors are left for the caller
+    static FInteractionBenchmarkResult EvaluateBudget(TArray<float> FrameTimes, int32 MaxTickingActors, const FMapPerformanceBudget& Budget);
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override { return bRunning || bStartPending; }
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+    UPROPERTY(Config)
+    int32 PickableItemCount = 64;
+
+    UPROPERTY(Config)
+    int32 FixableMachineCount = 16;
+
+    UPROPERTY(Config)
+    int32 OxygenReplenishCount = 16;
+
+    UPROPERTY(Config)
+    int32 WheepingAngleCount = 8;
+
+    UPROPERTY(Config)
+    int32 DialogueTriggerCount = 8;
+
+    // Optional Blueprint subclasses to spawn instead of the bare native classes (e.g. ones with meshes set up)
+    UPROPERTY(Config)
+    TSoftClassPtr<APickableItem> PickableItemClass;
+
+    UPROPERTY(Config)
+    TSoftClassPtr<AP_FixableMachine> FixableMachineClass;
+
+    UPROPERTY(Config)
+    TSoftClassPtr<AOxygenReplenishActor> OxygenReplenishClass;
+
+    UPROPERTY(Config)
+    TSoftClassPtr<AWheepingAngle> WheepingAngleClass;
+
+    UPROPERTY(Config)
+    TSoftClassPtr<ADialogueTrigger> DialogueTriggerClass;
+
+    UPROPERTY(Config)
+    int32 RandomSeed = 1337;
+
+    // Actors are scattered over a disc of this radius around the player's starting location
+    UPROPERTY(Config)
+    float SpawnRadius = 3000.0f;
+
+    UPROPERTY(Config)
+    float PathRadius = 1500.0f;
+
+    // Simulated seconds for one full orbit; the run lasts PathLaps orbits
+    UPROPERTY(Config)
+    float PathLapTime = 20.0f;
+
+    UPROPERTY(Config)
+    int32 PathLaps = 2;
+
+    // Name of a recording under Saved/InputReplays to play instead of the orbit (see UInputReplayComponent)
+    UPROPERTY(Config)
+    FString InputReplayName;
+
+    // Frames run before recording starts, so spawning and first-use costs stay out of the data
+    UPROPERTY(Config)
+    int32 WarmupFrames = 30;
+
+    UPROPERTY(Config)
+    float FixedDeltaTime = 1.0f / 60.0f;
+
+    // Used for maps without an entry in MapBudgets
+    UPROPERTY(Config)
+    FMapPerformanceBudget DefaultBudget;
+
+    UPROPERTY(Config)
+    TArray<FMapPerformanceBudget> MapBudgets;
+
+private:
+    struct FFrameSample
+    {
+        float GameThreadMs = 0.0f;
+        int32 TickingActors = 0;
+        int32 Traces = 0;
+        int32 FullTick = 0;
+        int32 ReducedTick = 0;
+        int32 DormantTick = 0;
+    };
+
+    template <typename T>
+    void SpawnPopulation(const TSoftClassPtr<T>& ClassOverride, int32 Count, FRandomStream& Random);
+
+    void DrivePath();
+    int32 GetInteractionTraceCount() const;
+    FString GetShortMapName() const;
+    void WriteCsv() const;
+
+    // Fills LastResult and appends it to the budget report; returns false if any limit was exceeded
+    bool CheckBudget();
+
+    // Loads the next map of an -InteractionBenchmarkMaps sweep, or exits once all have run
+    void AdvanceMapSweep(bool bWithinBudget);
+
+    TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+    TArray<FFrameSample> Samples;
+
+    FInteractionBenchmarkResult LastResult;
+    bool bHasResult = false;
+
+    FVector PathCenter = FVector::ZeroVector;
+    float SimulatedTime = 0.0f;
+    int32 FramesRun = 0;
+    int32 LastTraceCount = 0;
+    bool bRunning = false;
+    bool bStartPending = false;
+    bool bQuitOnFinish = false;
+    bool bOwnsCsvCapture = false;
+
+    TWeakObjectPtr<class UInputReplayComponent> ActiveReplay;
+    FDelegateHandle ReplayFinishedHandle;
+
+    TArray<FString> SweepMaps;
+    int32 SweepMapIndex = INDEX_NONE;
+    bool bSweepFailed = false;
+
+    bool bPreviousUseFixedTimeStep = false;
+    double PreviousFixedDeltaTime = 0.0;
+};
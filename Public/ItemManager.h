@@ -69,8 +69,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Item Management")
     void DropItem();
 
+    // Lets go of the held item on the spot, skipping the drop animation (used by checkpoint restore)
+    void ReleaseHeldItemImmediately();
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item Management")
     TArray<FPickableItemData> PickableItems;
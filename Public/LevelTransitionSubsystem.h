@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+#include "Engine/StreamableManager.h"
+#include "LevelTransitionSubsystem.generated.h"
+
+class UUserWidget;
+
+// Moves between maps without a blocking load. Callers preload the next map as soon as
+// it is known, then travel; the package is already resident by the time the map switches.
+UCLASS(Config = Game)
+class FIRSTPERSONTEST_API ULevelTransitionSubsystem : public UGameInstanceSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    static ULevelTransitionSubsystem* Get(const UObject* WorldContextObject);
+
+    // Starts loading the map package (and the loading overlay) in the background; does nothing if it is already loading or loaded
+    UFUNCTION(BlueprintCallable, Category = "Level Transition")
+    void PreloadLevel(FName LevelName);
+
+    // Shows the loading overlay and switches map, waiting for an in-flight preload of the same map first
+    UFUNCTION(BlueprintCallable, Category = "Level Transition")
+    void TravelToLevel(FName LevelName);
+
+    UFUNCTION(BlueprintPure, Category = "Level Transition")
+    bool IsLevelPreloaded(FName LevelName) const;
+
+protected:
+    // Lightweight overlay shown while the map switches (DefaultGame.ini)
+    UPROPERTY(Config)
+    TSoftClassPtr<UUserWidget> LoadingOverlayClass;
+
+    UPROPERTY(Config)
+    int32 LoadingOverlayZOrder = 10000;
+
+    // Uses ServerTravel so the game mode's seamless travel setting applies; otherwise OpenLevel
+    UPROPERTY(Config)
+    bool bUseSeamlessTravel = false;
+
+private:
+    void OnPreloadComplete(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+    void OnPostLoadMap(UWorld* LoadedWorld);
+    void ShowLoadingOverlay();
+    void SwitchToLevel(FName LevelName);
+
+    FString ResolveLevelPackage(FName LevelName);
+
+    // Short map name to long package name for every map in the asset registry, built on first use
+    TMap<FName, FName> MapPackagesByName;
+
+    FName PreloadLevelName;
+    FName PendingTravelLevel;
+    bool bPreloadInFlight = false;
+
+    // Strong reference so the preloaded map survives garbage collection until travel
+    UPROPERTY()
+    UPackage* PreloadedPackage = nullptr;
+
+    UPROPERTY()
+    UUserWidget* LoadingOverlay = nullptr;
+
+    // Keeps the loading overlay class resident once preloaded, so travel never loads it synchronously
+    TSharedPtr<FStreamableHandle> LoadingOverlayHandle;
+
+    FDelegateHandle PostLoadMapHandle;
+};
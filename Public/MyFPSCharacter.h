@@ -6,16 +6,22 @@
 #include "ItemNameWidget.h"
 #include "InteractManager.h"
 #include "PhysicsGrabComponent.h"  
+#include "InputReplayComponent.h"
 #include "MyFPSCharacter.generated.h"
 
 
 class AItemManager;
+class UCameraSwayModifier;
+class UCameraSwayProfile;
 
 UCLASS()
 class FIRSTPERSONTEST_API AMyFPSCharacter : public ACharacter
 {
     GENERATED_BODY()
 
+    // Reads the sway profiles and sprint state below
+    friend class UCameraSwayModifier;
+
 public:
     AMyFPSCharacter();
 
@@ -40,6 +46,17 @@ public:
     
     void RotateObject(float PitchInput, float YawInput);
 
+    UInputReplayComponent* GetInputReplay() const { return InputReplay; }
+    bool IsReplayingInput() const { return InputReplay && InputReplay->IsReplaying(); }
+
+    // Returns what the input bindings received since the last call and clears the per-frame actions
+    FRecordedInputFrame ConsumeLiveInput();
+
+    // Feeds one recorded frame through the same handlers live input uses
+    void ApplyInputFrame(const FRecordedInputFrame& Frame);
+
+    virtual void PostLoad() override;
+
 protected:
     virtual void BeginPlay() override;
 
@@ -50,6 +67,20 @@ protected:
     void StopSprint();
     float DefaultMaxWalkSpeed;
 
+    // Bound input handlers: capture the live values for recording and are ignored during a replay
+    void InputMoveForward(float Value);
+    void InputMoveRight(float Value);
+    void InputTurn(float Value);
+    void InputLookUp(float Value);
+    void InputActionPressed(EReplayInputAction Action);
+    void InputActionReleased(EReplayInputAction Action);
+    void DispatchAction(EReplayInputAction Action, bool bPressed);
+
+    FRecordedInputFrame LiveInput;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Input Replay")
+    UInputReplayComponent* InputReplay;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Physics")
     bool bEnablePhysicsInteraction = true;
 
@@ -59,26 +90,49 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement|Physics")
     float PushForcePointZOffset = 50.0f;
 
+    // Used while walking, and in place of the idle profile when that is unset. Without a sprint
+    // profile, sprinting uses this one with the built-in lean and bob boost. With no profile at all
+    // the built-in defaults apply.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway")
-    float PositionalSwayAmount = 10.0f;
+    UCameraSwayProfile* WalkSwayProfile = nullptr;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway")
-    float RotationalSwayAmount = 3.0f;
+    UCameraSwayProfile* IdleSwayProfile = nullptr;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway")
-    float SwaySpeed = 2.5f;
+    UCameraSwayProfile* SprintSwayProfile = nullptr;
 
+    // How quickly the camera crossfades between idle, walk and sprint profiles
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway")
-    float ReturnSpeed = 5.0f;
+    float SwayProfileBlendSpeed = 4.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway")
-    float LandingBobAmount = 10.0f;
+    // Scales the movement-driven tilt (RotationalSwayAmount) that reaches the view, and with it the
+    // aim of view-based traces. The camera used to follow control rotation exactly, so full strength
+    // would be a large change in feel; 0 keeps only the positional sway, sprint lean and breathing.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+    float RotationalSwayScale = 0.1f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway")
-    float BreathingAmount = 0.3f;
+    // Sway tuning from before the profiles; PostLoad moves any non-default values into a generated walk profile
+    UPROPERTY()
+    float PositionalSwayAmount_DEPRECATED = 10.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Camera|Sway")
-    float BreathingSpeed = 1.0f;
+    UPROPERTY()
+    float RotationalSwayAmount_DEPRECATED = 3.0f;
+
+    UPROPERTY()
+    float SwaySpeed_DEPRECATED = 2.5f;
+
+    UPROPERTY()
+    float ReturnSpeed_DEPRECATED = 5.0f;
+
+    UPROPERTY()
+    float LandingBobAmount_DEPRECATED = 10.0f;
+
+    UPROPERTY()
+    float BreathingAmount_DEPRECATED = 0.3f;
+
+    UPROPERTY()
+    float BreathingSpeed_DEPRECATED = 1.0f;
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
     TSubclassOf<UItemNameWidget> ItemNameWidgetClass;
@@ -98,14 +152,6 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Interaction")
     bool bAllowObjectRotation = true;
     
-    FRotator InitialCameraRotation;
-    FVector InitialCameraLocation;
-    FRotator CurrentRotationalSway;
-    FVector CurrentPositionalSway;
-    float BreathingPhase;
-    float LastZVelocity;
-    bool bWasInAir;
-    
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
     float SprintSpeedMultiplier = 1.5f;
     
@@ -116,8 +162,6 @@ private:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Camera, meta = (AllowPrivateAccess = "true"))
     UCameraComponent* FirstPersonCamera;
     
-    void HandleCameraSway(float DeltaTime);
-    
     void PerformCameraRaycast();
     
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Raycast", meta = (AllowPrivateAccess = "true"))
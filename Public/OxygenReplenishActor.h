@@ -19,6 +19,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -30,6 +31,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
 	float OxygenAmount = 50.0f;
 
+	// Used up after one interaction; the actor is hidden rather than destroyed so checkpoints can bring it back
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
 	bool bDestroyAfterUse = true;
 	
@@ -64,7 +66,13 @@ public:
 	void ShowInteractPrompt(bool bShow);
 	
 	UFUNCTION(BlueprintCallable, Category = "Interaction")
-	bool IsInteractable() const { return bCanInteract; }
+	bool IsInteractable() const { return bCanInteract && !bConsumed; }
+
+	UFUNCTION(BlueprintCallable, Category = "Oxygen System")
+	void SetConsumed(bool bInConsumed);
+
+	UFUNCTION(BlueprintPure, Category = "Oxygen System")
+	bool IsConsumed() const { return bConsumed; }
     
     // IInteractable interface
     UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Interaction")
@@ -90,5 +98,6 @@ public:
 
 private:
 	bool bCanInteract;
+	bool bConsumed = false;
 	APlayerOxygenSystem* PlayerOxygenSystem;
 };
\ No newline at end of file
@@ -27,6 +27,11 @@ protected:
     virtual bool CanInteract_Implementation() const override;
     virtual FText GetInteractionText_Implementation() const override;
 
+    // Hold-to-repair
+    virtual bool SupportsHold() const override { return true; }
+    virtual void BeginHold(AActor* Interactor) override;
+    virtual void EndHold(AActor* Interactor) override;
+
 public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UStaticMeshComponent* MachineMesh;
@@ -64,8 +69,12 @@ public:
     UFUNCTION(BlueprintPure, Category = "Machine")
     bool IsBeingFixed() const { return bIsBeingFixed; }
     
+    // Includes any decay since the repair was abandoned
     UFUNCTION(BlueprintPure, Category = "Machine")
-    float GetFixingProgress() const { return FixingProgress; }
+    float GetFixingProgress() const;
+
+    // Puts the machine back into a saved state without notifying the puzzle manager
+    void RestoreState(float InFixingProgress, bool bInIsFixed);
 
 protected:
     UPROPERTY()
@@ -76,7 +85,10 @@ protected:
 
     bool bIsFixed;
     bool bIsBeingFixed;
+
+    // Progress when the repair was abandoned; decay from it is derived from DecayStartTime on demand
     float FixingProgress;
+    float DecayStartTime = -1.0f;
 
     void UpdateFixingProgress(float DeltaTime);
     void CompleteFix();
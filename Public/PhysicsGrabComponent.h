@@ -9,6 +9,18 @@
 #include "Sound/SoundBase.h"
 #include "PhysicsGrabComponent.generated.h"
 
+class USplineMeshComponent;
+class UStaticMesh;
+
+UENUM(BlueprintType)
+enum class EPhysicsGrabMode : uint8
+{
+    // Carry only the body under the crosshair
+    Single,
+    // Also weld small bodies resting on it into one compound body until it is dropped or thrown
+    Stack
+};
+
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class FIRSTPERSONTEST_API UPhysicsGrabComponent : public UActorComponent
 {
@@ -56,6 +68,43 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab")
     USoundBase* ReleaseSound;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab|Stacking")
+    EPhysicsGrabMode GrabMode = EPhysicsGrabMode::Single;
+
+    // How far beyond the grabbed body's bounds to look for bodies to carry along
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab|Stacking", meta = (ClampMin = "0.0"))
+    float StackSearchMargin = 20.0f;
+
+    // Heavier bodies are left behind; the whole stack is still limited by MaxGrabMass
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab|Stacking", meta = (ClampMin = "0.0"))
+    float MaxStackedBodyMass = 10.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab|Stacking", meta = (ClampMin = "0"))
+    int32 MaxStackedBodies = 8;
+
+    // Arc shown while holding an object, predicting where ThrowObject would send it
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab|Throw Preview")
+    bool bShowThrowPreview = true;
+
+    // Deformed along the whole arc as a single spline mesh, so it should run along +X. No preview without one.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics Grab|Throw Preview")
+    UStaticMesh* ThrowPreviewMesh = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics Grab|Throw Preview")
+    UMaterialInterface* ThrowPreviewMaterial = nullptr;
+
+    // Points along the predicted arc; the buffer is sized once at BeginPlay
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics Grab|Throw Preview", meta = (ClampMin = "2", ClampMax = "128"))
+    int32 ThrowPreviewPoints = 32;
+
+    // Simulated seconds between points
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab|Throw Preview", meta = (ClampMin = "0.01"))
+    float ThrowPreviewTimeStep = 0.05f;
+
+    // Collision sweeps per frame; each segment of the arc is re-checked every (ThrowPreviewPoints - 1) / this frames
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics Grab|Throw Preview", meta = (ClampMin = "1"))
+    int32 ThrowPreviewSweepsPerFrame = 4;
+
     UFUNCTION(BlueprintCallable, Category = "Physics Grab")
     void StartGrab();
 
@@ -74,6 +123,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Physics Grab")
     AActor* GetGrabbedActor() const { return GrabbedActor; }
 
+    UFUNCTION(BlueprintCallable, Category = "Physics Grab")
+    int32 GetNumStackedBodies() const { return StackedComponents.Num(); }
+
 protected:
     UPROPERTY()
     bool bIsGrabbing = false;
@@ -102,12 +154,32 @@ protected:
     UPROPERTY()
     float CurrentRotationYaw = 0.0f;
 
+    UPROPERTY()
+    USplineMeshComponent* ThrowPreviewComponent = nullptr;
+
+    // Bodies welded to GrabbedComponent in Stack mode
+    TArray<TWeakObjectPtr<UPrimitiveComponent>> StackedComponents;
+
+    // Analytic arc, rewritten every frame
+    TArray<FVector> PreviewPoints;
+
+    // Per segment, the fraction that was clear when it was last swept (1 = unobstructed).
+    // Swept round-robin, so the collision budget per frame is fixed whatever the arc length.
+    TArray<float> PreviewSegmentClear;
+    int32 NextPreviewSegment = 0;
+
     void PerformGrabTrace();
     void UpdateGrabbedObject(float DeltaTime);
     void SetObjectHighlight(AActor* Actor, bool bHighlight);
     bool CanGrabObject(AActor* Actor, UPrimitiveComponent* Component) const;
+    float GetBodyMass(const AActor* Actor, const UPrimitiveComponent* Component) const;
+    void GatherStack();
+    void ReleaseStack(const FVector& VelocityChange);
     FVector GetGrabTargetLocation() const;
     void ApplyGrabForce(float DeltaTime);
+    FVector GetThrowVelocity() const;
+    void UpdateThrowPreview();
+    void HideThrowPreview();
     UCameraComponent* GetPlayerCamera() const;
     APlayerController* GetPlayerController() const;
 };
\ No newline at end of file
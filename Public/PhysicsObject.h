@@ -6,6 +6,8 @@
 #include "Sound/SoundBase.h"
 #include "PhysicsObject.generated.h"
 
+class UPhysicsPropProfile;
+
 UCLASS()
 class FIRSTPERSONTEST_API APhysicsObject : public AActor
 {
@@ -15,7 +17,9 @@ public:
     APhysicsObject();
 
 protected:
+    virtual void OnConstruction(const FTransform& Transform) override;
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     // Components
@@ -29,6 +33,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics")
     bool bCanBeDragged = true;
 
+    // CCD and sleep settings; the class defaults of UPhysicsPropProfile apply when unset
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics")
+    UPhysicsPropProfile* PropProfile = nullptr;
+
     // Visual Feedback
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visual")
     UMaterialInterface* HighlightMaterial;
@@ -49,13 +57,32 @@ public:
     UPROPERTY()
     float LastCollisionSoundTime = 0.0f;
 
+    // Beyond this distance from the listener the physics engine stops reporting hits for this object. 0 disables culling.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Audio", meta = (ClampMin = "0.0"))
+    float HitNotifyCullDistance = 3000.0f;
+
+    // Use this rather than setting CollisionSound directly at runtime, so hit notifications follow it
+    UFUNCTION(BlueprintCallable, Category = "Audio")
+    void SetCollisionSound(USoundBase* NewSound);
+
     UFUNCTION(BlueprintCallable, Category = "Physics")
     void Highlight(bool bHighlight);
 
     UFUNCTION(BlueprintCallable, Category = "Physics")
     bool CanBeDragged() const { return bCanBeDragged; }
 
+    // Mass of ObjectMesh as of BeginPlay, so per-frame checks don't query the physics body
+    float GetCachedMass() const { return CachedMass; }
+
 protected:
+    // Copies the profile onto the body instance, updating or rebuilding the live body if it already exists
+    void ApplyPropProfile();
+
+    // Level-placed and with something directly underneath, i.e. safe to start asleep
+    bool IsRestingPlacedProp(const UPhysicsPropProfile& Profile) const;
+
+    float CachedMass = 0.0f;
+
     // Collision sounds
     UFUNCTION()
     void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
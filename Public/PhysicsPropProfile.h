@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "PhysicsPropProfile.generated.h"
+
+UENUM(BlueprintType)
+enum class EPhysicsPropCCD : uint8
+{
+    // CCD only when the prop is thin enough to tunnel at MaxExpectedSpeed
+    Auto,
+    Always,
+    Never
+};
+
+// Simulation settings shared by a family of APhysicsObject props (crates, bottles, debris...).
+// Lets a room full of props skip CCD where it cannot matter and fall asleep as soon as it settles.
+UCLASS(BlueprintType)
+class FIRSTPERSONTEST_API UPhysicsPropProfile : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // Whether a prop whose thinnest half-extent is HalfThickness needs continuous collision detection
+    bool NeedsCCD(float HalfThickness) const;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision")
+    EPhysicsPropCCD CCDPolicy = EPhysicsPropCCD::Auto;
+
+    // Fastest the prop is expected to move (cm/s); the default matches UPhysicsGrabComponent::ThrowForce
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision", meta = (ClampMin = "0.0", EditCondition = "CCDPolicy == EPhysicsPropCCD::Auto"))
+    float MaxExpectedSpeed = 1500.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Collision", meta = (ClampMin = "0.001", EditCondition = "CCDPolicy == EPhysicsPropCCD::Auto"))
+    float SimulationStepTime = 1.0f / 60.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sleep")
+    ESleepFamily SleepFamily = ESleepFamily::Custom;
+
+    // Only used with the Custom sleep family; higher puts slowly settling props to sleep sooner
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sleep", meta = (ClampMin = "0.0"))
+    float SleepThresholdMultiplier = 4.0f;
+
+    // Level-placed props already resting on something start asleep, so a room does not simulate until
+    // the player disturbs it. Spawned and floating props always start awake and fall as usual.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sleep")
+    bool bStartAsleep = false;
+
+    // How far below a placed prop a surface may be for it to count as resting on it (cm)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Sleep", meta = (ClampMin = "0.0", EditCondition = "bStartAsleep"))
+    float RestingContactTolerance = 2.0f;
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "TickSignificanceSubsystem.h"
 #include "PickableItem.generated.h"
 
 UCLASS()
@@ -38,6 +39,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // Mesh component for the item
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
@@ -99,6 +101,10 @@ protected:
     UPROPERTY()
     FVector CurrentSwayOffset;
 
+    // Applies while the item is on the ground; a held item always ticks every frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+    FTickSignificanceSettings TickSignificance;
+
 public:
     virtual void Highlight(bool bHighlight);
 };
\ No newline at end of file
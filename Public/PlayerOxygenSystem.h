@@ -7,6 +7,7 @@
 #include "Components/Image.h"
 #include "Components/TextBlock.h"
 #include "TimerManager.h"
+#include "HUDLayerLibrary.h"
 #include "PlayerOxygenSystem.generated.h"
 
 UCLASS()
@@ -19,6 +20,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	virtual void Tick(float DeltaTime) override;
@@ -44,6 +46,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
 	FName RestartLevelName;
 
+	// Restart the current level by restoring the last checkpoint in place instead of reloading the map
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
+	bool bRestartFromCheckpoint = true;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
 	TSubclassOf<UUserWidget> HUDWidgetClass;
 
@@ -51,6 +57,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
 	TSubclassOf<UUserWidget> ScreenOverlayWidgetClass;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
+	FHUDLayerSettings HUDLayer;
+
+	// The tint animates every frame at low oxygen, so it is uncached by default
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Oxygen System")
+	FHUDLayerSettings ScreenOverlayLayer;
+
 	UPROPERTY()
 	UUserWidget* HUDWidget;
 
@@ -89,6 +102,10 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Oxygen System")
 	void RestartGame();
+
+	// Sets oxygen directly and cancels any pending game over
+	UFUNCTION(BlueprintCallable, Category = "Oxygen System")
+	void RestoreOxygen(float Amount);
 	UFUNCTION(BlueprintPure, Category = "Oxygen System")
 	float GetOxygenPercentage() const { return CurrentOxygen / MaxOxygen; }
 	UFUNCTION(BlueprintPure, Category = "Oxygen System")
@@ -98,5 +115,8 @@ private:
 	FTimerHandle GameOverTimerHandle;
 	bool bGameOverTriggered = false;
 
+	// Last percentage pushed to OxygenLabel, so the cached HUD layer is only invalidated on change
+	int32 LastDisplayedOxygenPercentage = INDEX_NONE;
+
 	void TriggerGameOver();
 };
\ No newline at end of file
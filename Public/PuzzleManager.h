@@ -4,9 +4,11 @@
 #include "GameFramework/Actor.h"
 #include "Components/PointLightComponent.h"
 #include "Engine/PointLight.h"
+#include "HUDLayerLibrary.h"
 #include "PuzzleManager.generated.h"
 
 class AP_FixableMachine;
+class ULevelStreaming;
 class UUserWidget;
 class UProgressBar;
 class UTextBlock;
@@ -36,6 +38,19 @@ struct FPuzzleData
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Puzzle")
     bool bIsActive = false;
+
+    // Optional sublevel holding this puzzle's room. It must be listed in the persistent level's
+    // streaming levels; the manager loads it ahead of the puzzle and unloads it once solved.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Puzzle|Streaming")
+    TSoftObjectPtr<UWorld> RoomLevel;
+
+    // Machine placed inside RoomLevel (hard references cannot cross levels); resolved into Machine when the room loads
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Puzzle|Streaming")
+    TSoftObjectPtr<AP_FixableMachine> RoomMachine;
+
+    // Keep the room resident after the puzzle is solved, e.g. when the player has to walk back through it
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Puzzle|Streaming")
+    bool bKeepRoomLoadedWhenComplete = false;
 };
 
 USTRUCT(BlueprintType)
@@ -85,6 +100,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void Tick(float DeltaTime) override;
 
 public:
@@ -94,6 +110,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
     TSubclassOf<UUserWidget> PlayerHUDWidgetClass;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
+    FHUDLayerSettings HUDLayer;
+
+    // Objective and task labels only change when a puzzle advances
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
+    FHUDLayerSettings PlayerHUDLayer;
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Puzzle")
     TArray<FPuzzleData> PuzzleData;
 
@@ -109,6 +132,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lighting")
     bool bUseInterpolation = true;
 
+    // Completion of the active puzzle at which the next puzzle's room starts streaming in
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Puzzle|Streaming", meta = (ClampMin = "0.0", ClampMax = "100.0"))
+    float StreamNextRoomAtCompletion = 50.0f;
+
+    // A solved room is only unloaded once the player is at least this far outside its bounds
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Puzzle|Streaming", meta = (ClampMin = "0.0"))
+    float RoomExitMargin = 200.0f;
+
     UPROPERTY()
     UUserWidget* HUDWidget;
 
@@ -133,7 +164,7 @@ public:
     void OnMachineStartFixing(AP_FixableMachine* Machine);
     void OnMachineStopFixing(AP_FixableMachine* Machine);
     void OnMachineFixed(AP_FixableMachine* Machine);
-    void UpdateFixingProgress(float Progress);
+    void UpdateFixingProgress(AP_FixableMachine* Machine, float Progress);
     void ShowInteractionUI(bool bShow, const FText& Text = FText::GetEmpty());
     void HideProgressBar();
 
@@ -155,6 +186,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Puzzle")
     void ActivateNextPuzzle();
 
+    // Re-derives HUD, lights and progression after PuzzleData was restored from a checkpoint
+    void RefreshRestoredState(int32 InCurrentPuzzleIndex);
+
     UFUNCTION(BlueprintCallable, Category = "Lighting")
     void UpdatePointLights();
 
@@ -172,9 +206,25 @@ protected:
     void UpdatePlayerHUDLabels();
     void SortPuzzlesByOrder();
 
+    // Loads the active and upcoming rooms and unloads solved ones
+    void UpdateRoomStreaming();
+    void SetRoomLoaded(int32 PuzzleIndex, bool bLoaded);
+    void ResolveRoomMachines();
+    bool IsPlayerInRoom(int32 PuzzleIndex);
+
     UFUNCTION()
-    void OnAllMachinesFixed();
+    void OnRoomLevelShown();
 
+    // Streaming level per PuzzleData entry (null when the puzzle has no room), resolved once in BeginPlay
     UPROPERTY()
-    AP_FixableMachine* CurrentHighlightedMachine;
+    TArray<ULevelStreaming*> RoomStreamingLevels;
+
+    // Bounds of each loaded room, computed the first time they are needed and reset on unload
+    TArray<FBox> RoomBounds;
+
+    // Re-checks solved rooms waiting for the player to leave before they unload
+    FTimerHandle RoomUnloadCheckTimer;
+
+    UFUNCTION()
+    void OnAllMachinesFixed();
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TickSignificanceSubsystem.generated.h"
+
+UENUM(BlueprintType)
+enum class ETickSignificance : uint8
+{
+    // Ticks every frame
+    Full,
+    // Ticks on ReducedTickInterval; the engine hands Tick the accumulated delta
+    Reduced,
+    // Tick disabled until the player gets close again, then put back to whatever the actor had chosen
+    Dormant
+};
+
+// Per-actor distances that decide which tick bucket an actor lands in
+USTRUCT(BlueprintType)
+struct FTickSignificanceSettings
+{
+    GENERATED_BODY()
+
+    // Within this distance of the player's view point the actor ticks every frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tick Significance", meta = (ClampMin = "0.0"))
+    float FullTickDistance = 1500.0f;
+
+    // Between FullTickDistance and this distance the actor ticks on ReducedTickInterval
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tick Significance", meta = (ClampMin = "0.0"))
+    float ReducedTickDistance = 4000.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tick Significance", meta = (ClampMin = "0.0"))
+    float ReducedTickInterval = 0.1f;
+
+    // Actors behind the camera are treated as this much further away
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tick Significance", meta = (ClampMin = "1.0"))
+    float BehindViewDistanceScale = 2.0f;
+
+    // Actors whose behaviour must keep running when far away (e.g. they react to the player's view) stay Reduced at worst
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tick Significance")
+    bool bAllowDormant = true;
+};
+
+// Moves registered actors between tick buckets based on distance and facing relative to the
+// local player's view, so tick cost follows what the player can actually interact with.
+// A fixed number of actors is re-evaluated each frame, round-robin.
+UCLASS(Config = Game)
+class FIRSTPERSONTEST_API UTickSignificanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    static UTickSignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+    void RegisterActor(AActor* Actor, const FTickSignificanceSettings& Settings);
+    void UnregisterActor(AActor* Actor);
+
+    // Pinned actors tick every frame regardless of significance (e.g. while the player is using them)
+    void SetPinned(AActor* Actor, bool bPinned);
+
+    ETickSignificance GetSignificance(const AActor* Actor) const;
+    int32 GetNumInBucket(ETickSignificance Bucket) const { return BucketCounts[static_cast<int32>(Bucket)]; }
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual ETickableTickType GetTickableTickType() const override;
+    virtual bool IsTickable() const override;
+    virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+protected:
+    UPROPERTY(Config)
+    int32 ActorsEvaluatedPerFrame = 64;
+
+    // Fraction a threshold must be exceeded by before an actor drops to a cheaper bucket
+    UPROPERTY(Config)
+    float Hysteresis = 0.1f;
+
+private:
+    struct FEntry
+    {
+        const AActor* Key = nullptr;
+        TWeakObjectPtr<AActor> Actor;
+        FTickSignificanceSettings Settings;
+        ETickSignificance Bucket = ETickSignificance::Full;
+        float OriginalTickInterval = 0.0f;
+        // The actor's own choice, so actors that switched their tick off stay off when they come back in range
+        bool bOwnerTickEnabled = true;
+        bool bPinned = false;
+    };
+
+    void Evaluate(FEntry& Entry, const FVector& ViewLocation, const FVector& ViewDirection);
+    void ApplyBucket(FEntry& Entry, ETickSignificance NewBucket);
+    void RemoveAt(int32 Index);
+
+    TArray<FEntry> Entries;
+    TMap<const AActor*, int32> IndexByActor;
+    int32 NextEntryToEvaluate = 0;
+    int32 BucketCounts[3] = { 0, 0, 0 };
+};
@@ -84,4 +84,20 @@ public:
     
     // Function to update the timer text display
     void UpdateTimerDisplay();
+
+private:
+    // Writes "mm:ss" or "mm:ss.hh" into TimeStringBuffer without going through Printf
+    void FormatTime(int32 TotalHundredths);
+    void UpdateTimerColor();
+
+    // Reused between updates so formatting does not reallocate
+    FString TimeStringBuffer;
+
+    // Last value pushed to TimerText (hundredths or whole seconds), INDEX_NONE forces a refresh
+    int32 LastDisplayedValue = INDEX_NONE;
+    bool bLastShowMilliseconds = false;
+
+    // Whether the warning color is currently applied, and whether NormalColor must be re-applied
+    bool bInWarningBand = false;
+    bool bColorDirty = true;
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Blueprint/UserWidget.h"
+#include "HUDLayerLibrary.h"
 #include "UIContainerActor.generated.h"
 
 UCLASS()
@@ -25,9 +26,6 @@ protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:    
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
 	// Component to attach UI to
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	class USceneComponent* RootSceneComponent;
@@ -35,6 +33,10 @@ public:
 	// The list of widget classes to create and add to viewport
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
 	TArray<TSubclassOf<UUserWidget>> WidgetClasses;
+
+	// Caching applied to every widget this container creates
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI")
+	FHUDLayerSettings LayerSettings;
     
 	// The list of created widget instances (runtime)
 	UPROPERTY()
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "TickSignificanceSubsystem.h"
 #include "WheepingAngle.generated.h"
 
 UCLASS()
@@ -69,6 +70,10 @@ public:
     UPROPERTY(EditAnywhere, Category = "Debug")
     float DebugBreakDelay;
 
+    // The angel reacts to the player's view from any distance, so it never goes fully dormant by default
+    UPROPERTY(EditAnywhere, Category = "Performance")
+    FTickSignificanceSettings TickSignificance;
+
 private:
     UPROPERTY(VisibleAnywhere, Category = "Components")
     USceneComponent* Root;
@@ -79,5 +84,10 @@ private:
 
     FTimerHandle DebugBreakTimerHandle;
 
+    // Counts a shard out of STAT_LiveShards whenever it goes, whether its lifespan ran out or the level unloaded.
+    // Bound on the class default object, which outlives every angel, so it fires even after the angel is gone.
+    UFUNCTION()
+    void OnShardEndPlay(AActor* Shard, EEndPlayReason::Type EndPlayReason);
+
     void TeleportBehindPlayer(const FVector& PlayerLocation, const FRotator& PlayerRotation);
 };
\ No newline at end of file